@@ -0,0 +1,179 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "list.h"
+
+//List of strings stored back to back in one character arena, plus an (offset, length) table.
+//Millions of strings cost two allocations (arena + table) instead of one heap block per string past the SSO limit,
+//and scans read the arena sequentially. Elements are accessed as std::string_view.
+//Removing or growing an element leaves its old characters behind as dead bytes, which are reclaimed by Compact() -
+//called automatically once dead bytes outweigh live ones.
+//Note: string_views returned by Get/[]/iteration are invalidated by any mutating call (the arena may move).
+class StringList {
+    struct Entry {
+        size_t offset;
+        size_t length;
+    };
+
+public:
+    static constexpr size_t npos = size_t(-1);
+
+    class Iterator {
+    public:
+        Iterator(const char* arena, const Entry* entry) : arena(arena), entry(entry) {}
+
+        std::string_view operator*() const { return std::string_view(arena + entry->offset, entry->length); }
+        Iterator& operator++() {
+            ++entry;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return entry == other.entry; }
+        bool operator!=(const Iterator& other) const { return entry != other.entry; }
+
+    private:
+        const char* arena;
+        const Entry* entry;
+    };
+
+    StringList() : deadBytes(0) {
+
+    }
+
+
+    size_t Count() const { return entries.Count(); }
+    size_t ArenaBytes() const { return arena.Count(); }
+    size_t DeadBytes() const { return deadBytes; }
+
+    void Clear() {
+        arena.Clear();
+        entries.Clear();
+        deadBytes = 0;
+    }
+
+    void Capacity(size_t strings, size_t characters) {
+        entries.Capacity(strings);
+        arena.Capacity(characters);
+    }
+
+    void Print() const {
+        std::cout << "(";
+        for (size_t i = 0; i < Count(); i++) {
+            std::cout << (*this)[i] << (i + 1 < Count() ? ", " : "");
+        }
+        std::cout << ")\n";
+    }
+
+    void Add(std::string_view value) {
+        const size_t offset = arena.Count();
+        arena.AddRange(value.data(), value.data() + value.size());
+        entries.Add(Entry{ offset, value.size() });
+    }
+
+    std::string_view operator[](size_t index) const {
+        const Entry& entry = entries[index];
+        return std::string_view(arena.begin() + entry.offset, entry.length);
+    }
+    std::string_view Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    //Index of the first element equal to val, npos if none - compares lengths before touching any characters
+    size_t Find(std::string_view val) const {
+        return FindIf([&](std::string_view e) { return e == val; });
+    }
+
+    template <typename Predicate>
+    size_t FindIf(Predicate&& pred) const {
+        for (size_t i = 0; i < Count(); i++) {
+            if (pred((*this)[i])) return i;
+        }
+        return npos;
+    }
+
+    //Appends suffix to element index (the demo's str += "[processed]"): in place if the element is the last one in
+    //the arena, otherwise the element is relocated to the arena tail and its old characters become dead bytes
+    void Append(size_t index, std::string_view suffix) {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot append to element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        Entry& entry = entries[index];
+        if (entry.offset + entry.length != arena.Count()) {
+            //suffix may point into the arena (eg: appending an element to another) - find it again if the arena moves
+            const bool inside = suffix.data() >= arena.begin() && suffix.data() < arena.end();
+            const size_t suffixOffset = inside ? size_t(suffix.data() - arena.begin()) : 0;
+
+            const size_t oldOffset = entry.offset;
+            entry.offset = arena.Count();
+            arena.AddRange(arena.begin() + oldOffset, arena.begin() + oldOffset + entry.length);
+            deadBytes += entry.length;
+
+            if (inside) suffix = std::string_view(arena.begin() + suffixOffset, suffix.size());
+            arena.AddRange(suffix.data(), suffix.data() + suffix.size());
+        }
+        else {
+            arena.AddRange(suffix.data(), suffix.data() + suffix.size());
+        }
+        entry.length += suffix.size();
+
+        CompactIfWasteful();
+    }
+
+    void RemoveAt(size_t index) {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        deadBytes += entries[index].length;
+        entries.RemoveAt(index);
+        CompactIfWasteful();
+    }
+
+    size_t Remove(std::string_view val) {
+        return RemoveIf([&](std::string_view e) { return e == val; });
+    }
+
+    //Only the (offset, length) table is compacted - removed characters stay in the arena as dead bytes
+    template <typename Predicate>
+    size_t RemoveIf(Predicate&& pred) {
+        const char* chars = arena.begin();
+        const size_t removed = entries.RemoveIf([&](const Entry& entry) {
+            if (!pred(std::string_view(chars + entry.offset, entry.length))) return false;
+            deadBytes += entry.length;
+            return true;
+        });
+        CompactIfWasteful();
+        return removed;
+    }
+
+    //Rewrites the arena with only live characters, in element order
+    void Compact() {
+        if (deadBytes == 0) return;
+
+        List<char> compacted;
+        compacted.Capacity(arena.Count() - deadBytes);
+        for (auto& entry : entries) {
+            const size_t offset = compacted.Count();
+            compacted.AddRange(arena.begin() + entry.offset, arena.begin() + entry.offset + entry.length);
+            entry.offset = offset;
+        }
+
+        arena = std::move(compacted);
+        deadBytes = 0;
+    }
+
+    Iterator begin() const { return Iterator(arena.begin(), entries.begin()); }
+    Iterator end() const { return Iterator(arena.begin(), entries.end()); }
+
+
+
+private:
+    List<char> arena;
+    List<Entry> entries;
+    size_t deadBytes;
+
+    void CompactIfWasteful() {
+        if (deadBytes > arena.Count() / 2) Compact();
+    }
+};
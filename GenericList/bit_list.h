@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "list.h"
+
+namespace bit_detail {
+    inline size_t PopCount(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return size_t(__popcnt64(word));
+#else
+        return size_t(__builtin_popcountll(word));
+#endif
+    }
+
+    //Index of the lowest set bit - word must not be 0
+    inline size_t CountTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return size_t(index);
+#else
+        return size_t(__builtin_ctzll(word));
+#endif
+    }
+
+    //Bits needed to hold word (0 for 0)
+    inline unsigned BitWidth(uint64_t word) {
+        if (word == 0) return 0;
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse64(&index, word);
+        return unsigned(index) + 1;
+#else
+        return 64 - unsigned(__builtin_clzll(word));
+#endif
+    }
+}
+
+//Packed list of flags: 64 per uint64_t word (8x smaller than List<bool>), so counting, searching and
+//AND/OR/XOR/NOT between lists work a whole word at a time.
+//Invariant: bits past Count() in the last word are always 0, so word-level operations never see stale flags.
+class BitList {
+public:
+    static constexpr size_t npos = size_t(-1);
+
+    BitList() : count(0) {
+
+    }
+
+    //count flags, all set to value
+    BitList(size_t count, bool value) : count(0) {
+        words.Capacity(WordCount(count));
+        for (size_t i = 0; i < WordCount(count); i++) {
+            words.Add(value ? ~uint64_t(0) : uint64_t(0));
+        }
+        this->count = count;
+        ClearTail();
+    }
+
+
+    size_t Count() const { return count; }
+
+    void Clear() {
+        words.Clear();
+        count = 0;
+    }
+
+    void Add(bool value) {
+        if (count % 64 == 0) words.Add(uint64_t(0));
+        if (value) words[count / 64] |= Bit(count);
+        ++count;
+    }
+
+    //Appends the low bits flags of word (bits <= 64), flag i = bit i
+    void AddWord(uint64_t word, size_t bits) {
+        if (bits > 64) throw std::invalid_argument(std::string("Cannot add more than 64 flags from a word: ") + std::to_string(bits) + std::string("."));
+        if (bits == 0) return; //would otherwise append an empty word when count is a multiple of 64
+        if (bits < 64) word &= Bit(bits) - 1;
+        const size_t used = count % 64;
+        if (used == 0) words.Add(word);
+        else {
+            words[words.Count() - 1] |= word << used;
+            if (used + bits > 64) words.Add(word >> (64 - used));
+        }
+        count += bits;
+    }
+
+    bool operator[](size_t index) const { return (words[index / 64] & Bit(index)) != 0; }
+    bool Get(size_t index) const {
+        if (index >= count) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    void Set(size_t index, bool value) {
+        if (index >= count) throw std::out_of_range(std::string("Cannot set element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        if (value) words[index / 64] |= Bit(index);
+        else words[index / 64] &= ~Bit(index);
+    }
+
+    //Amount of set flags (popcount per word)
+    size_t CountSet() const {
+        size_t set = 0;
+        for (uint64_t word : words) {
+            set += bit_detail::PopCount(word);
+        }
+        return set;
+    }
+
+    //Index of the first set flag at or after from, npos if none - skips 64 clear flags per step
+    size_t FindNextSet(size_t from) const {
+        if (from >= count) return npos;
+
+        size_t wordIndex = from / 64;
+        uint64_t word = words[wordIndex] & (~uint64_t(0) << (from % 64));
+        while (word == 0) {
+            if (++wordIndex == words.Count()) return npos;
+            word = words[wordIndex];
+        }
+        return wordIndex * 64 + bit_detail::CountTrailingZeros(word);
+    }
+    size_t FindFirstSet() const { return FindNextSet(0); }
+
+    //Calls func(index) for each set flag, in increasing order
+    template <typename Func>
+    void ForEachSet(Func&& func) const {
+        for (size_t wordIndex = 0; wordIndex < words.Count(); wordIndex++) {
+            for (uint64_t word = words[wordIndex]; word != 0; word &= word - 1) { //word & (word - 1) clears the lowest set bit
+                func(wordIndex * 64 + bit_detail::CountTrailingZeros(word));
+            }
+        }
+    }
+
+
+    //Word-level bulk operations - both lists must have the same Count
+    BitList& operator&=(const BitList& other) {
+        CheckSameCount(other);
+        for (size_t i = 0; i < words.Count(); i++) words[i] &= other.words[i];
+        return *this;
+    }
+    BitList& operator|=(const BitList& other) {
+        CheckSameCount(other);
+        for (size_t i = 0; i < words.Count(); i++) words[i] |= other.words[i];
+        return *this;
+    }
+    BitList& operator^=(const BitList& other) {
+        CheckSameCount(other);
+        for (size_t i = 0; i < words.Count(); i++) words[i] ^= other.words[i];
+        return *this;
+    }
+
+    //Flips every flag
+    void Not() {
+        for (auto& word : words) word = ~word;
+        ClearTail();
+    }
+
+    friend BitList operator&(BitList first, const BitList& second) { return first &= second; }
+    friend BitList operator|(BitList first, const BitList& second) { return first |= second; }
+    friend BitList operator^(BitList first, const BitList& second) { return first ^= second; }
+    friend BitList operator~(BitList list) {
+        list.Not();
+        return list;
+    }
+
+    //Raw words, 64 flags each (flag i is bit i % 64 of word i / 64)
+    const uint64_t* Words() const { return words.begin(); }
+    size_t WordCount() const { return words.Count(); }
+
+
+
+private:
+    List<uint64_t> words;
+    size_t count;
+
+    static size_t WordCount(size_t bits) { return (bits + 63) / 64; }
+    static uint64_t Bit(size_t index) { return uint64_t(1) << (index % 64); }
+
+    void ClearTail() {
+        if (count % 64 != 0) words[words.Count() - 1] &= (uint64_t(1) << (count % 64)) - 1;
+    }
+
+    void CheckSameCount(const BitList& other) const {
+        if (other.count != count) throw std::invalid_argument(std::string("Cannot combine BitLists of different counts: ") + std::to_string(count) + std::string(" and ") + std::to_string(other.count) + std::string("."));
+    }
+};
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "list.h"
+#include "bit_list.h"
+
+namespace gorilla_detail {
+    constexpr size_t blockSize = 256;
+
+    //Appends bit fields (least significant bit first) to a List of words
+    class BitWriter {
+    public:
+        BitWriter() : bitCount(0) {}
+
+        size_t BitCount() const { return bitCount; }
+        const List<uint64_t>& Words() const { return words; }
+
+        void Clear() {
+            words.Clear();
+            bitCount = 0;
+        }
+
+        //value must fit in bits (1 - 64)
+        void Write(uint64_t value, unsigned bits) {
+            const unsigned used = unsigned(bitCount % 64);
+            if (used == 0) words.Add(uint64_t(0));
+            words[words.Count() - 1] |= value << used;
+            if (used + bits > 64) words.Add(value >> (64 - used));
+            bitCount += bits;
+        }
+
+    private:
+        List<uint64_t> words;
+        size_t bitCount;
+    };
+
+    class BitReader {
+    public:
+        BitReader(const uint64_t* words, size_t position) : words(words), position(position) {}
+
+        uint64_t Read(unsigned bits) {
+            const size_t word = position / 64;
+            const unsigned shift = unsigned(position % 64);
+            uint64_t value = words[word] >> shift;
+            if (shift + bits > 64) value |= words[word + 1] << (64 - shift);
+            position += bits;
+            return bits == 64 ? value : value & ((uint64_t(1) << bits) - 1);
+        }
+
+        bool ReadBit() { return Read(1) != 0; }
+
+    private:
+        const uint64_t* words;
+        size_t position;
+    };
+
+    //XOR with the previous value: 0 for a repeat, 10 + bits inside the previous leading/trailing zero window,
+    //11 + 5 bit leading zeros + 6 bit length + bits otherwise. Blocks start with a raw 64 bit value.
+    struct XorCodec {
+        static constexpr unsigned noWindow = 64;
+
+        uint64_t previous = 0;
+        unsigned leading = noWindow;
+        unsigned trailing = 0;
+
+        void Encode(BitWriter& writer, uint64_t value, bool blockStart) {
+            const uint64_t x = value ^ previous;
+            previous = value;
+            if (blockStart) {
+                writer.Write(value, 64);
+                leading = noWindow;
+                return;
+            }
+            if (x == 0) {
+                writer.Write(0, 1);
+                return;
+            }
+
+            const unsigned lz = std::min(64 - bit_detail::BitWidth(x), 31u);
+            const unsigned tz = unsigned(bit_detail::CountTrailingZeros(x));
+            if (leading != noWindow && lz >= leading && tz >= trailing) {
+                writer.Write(1, 2);
+                writer.Write(x >> trailing, 64 - leading - trailing);
+                return;
+            }
+
+            const unsigned meaningful = 64 - lz - tz;
+            writer.Write(3, 2);
+            writer.Write(lz, 5);
+            writer.Write(meaningful - 1, 6);
+            writer.Write(x >> tz, meaningful);
+            leading = lz;
+            trailing = tz;
+        }
+
+        uint64_t Decode(BitReader& reader, bool blockStart) {
+            if (blockStart) {
+                previous = reader.Read(64);
+                leading = noWindow;
+                return previous;
+            }
+            if (!reader.ReadBit()) return previous;
+
+            if (reader.ReadBit()) {
+                leading = unsigned(reader.Read(5));
+                trailing = 64 - leading - (unsigned(reader.Read(6)) + 1);
+            }
+            previous ^= reader.Read(64 - leading - trailing) << trailing;
+            return previous;
+        }
+    };
+
+    //Delta of delta: 0 for a steady interval, then 7/9/12 bit buckets for small jitter, 64 raw bits otherwise
+    struct DeltaOfDeltaCodec {
+        uint64_t previous = 0;
+        uint64_t delta = 0;
+
+        void Encode(BitWriter& writer, uint64_t value, bool blockStart) {
+            const uint64_t newDelta = value - previous;
+            const int64_t dod = int64_t(newDelta - delta);
+            previous = value;
+            if (blockStart) {
+                writer.Write(value, 64);
+                delta = 0;
+                return;
+            }
+            delta = newDelta;
+
+            if (dod == 0) writer.Write(0, 1);
+            else if (dod >= -63 && dod <= 64) {
+                writer.Write(1, 2);
+                writer.Write(uint64_t(dod + 63), 7);
+            }
+            else if (dod >= -255 && dod <= 256) {
+                writer.Write(3, 3);
+                writer.Write(uint64_t(dod + 255), 9);
+            }
+            else if (dod >= -2047 && dod <= 2048) {
+                writer.Write(7, 4);
+                writer.Write(uint64_t(dod + 2047), 12);
+            }
+            else {
+                writer.Write(15, 4);
+                writer.Write(uint64_t(dod), 64);
+            }
+        }
+
+        uint64_t Decode(BitReader& reader, bool blockStart) {
+            if (blockStart) {
+                previous = reader.Read(64);
+                delta = 0;
+                return previous;
+            }
+
+            int64_t dod = 0;
+            if (!reader.ReadBit()) dod = 0;
+            else if (!reader.ReadBit()) dod = int64_t(reader.Read(7)) - 63;
+            else if (!reader.ReadBit()) dod = int64_t(reader.Read(9)) - 255;
+            else if (!reader.ReadBit()) dod = int64_t(reader.Read(12)) - 2047;
+            else dod = int64_t(reader.Read(64));
+
+            delta += uint64_t(dod);
+            previous += delta;
+            return previous;
+        }
+    };
+
+    //Append-only bit stream of codec encoded 64 bit values, with the bit offset of every blockSize-th value
+    //recorded so Get decodes at most one block
+    template <typename Codec>
+    class BlockStream {
+    public:
+        BlockStream() : count(0) {}
+
+        size_t Count() const { return count; }
+        size_t MemoryBytes() const { return writer.Words().Count() * sizeof(uint64_t) + checkpoints.Count() * sizeof(size_t); }
+
+        void Clear() {
+            writer.Clear();
+            checkpoints.Clear();
+            encoder = Codec();
+            count = 0;
+        }
+
+        void Add(uint64_t value) {
+            const bool blockStart = count % blockSize == 0;
+            if (blockStart) checkpoints.Add(writer.BitCount());
+            encoder.Encode(writer, value, blockStart);
+            ++count;
+        }
+
+        uint64_t Get(size_t index) const {
+            return Cursor(this, index).Value();
+        }
+
+        //Sequential decoder - starts at the checkpoint of index's block, after that the stream is read contiguously
+        class Cursor {
+        public:
+            Cursor(const BlockStream* stream, size_t index) : stream(stream), reader(stream->writer.Words().begin(), index < stream->count ? stream->checkpoints[index / blockSize] : 0), index(index), value(0) {
+                if (index >= stream->count) return;
+                value = decoder.Decode(reader, true);
+                for (size_t i = 1; i <= index % blockSize; i++) value = decoder.Decode(reader, false);
+            }
+
+            uint64_t Value() const { return value; }
+            size_t Index() const { return index; }
+
+            void Next() {
+                if (++index < stream->count) value = decoder.Decode(reader, index % blockSize == 0);
+            }
+
+        private:
+            const BlockStream* stream;
+            BitReader reader;
+            Codec decoder;
+            size_t index;
+            uint64_t value;
+        };
+
+    private:
+        BitWriter writer;
+        List<size_t> checkpoints;
+        Codec encoder;
+        size_t count;
+    };
+
+    inline uint64_t ToBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline double FromBits(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+//Append-only List<double> for metric windows, compressed Gorilla-style: each value is XORed with the previous one and
+//only the bits between the XOR's leading and trailing zeros are stored (1 bit for a repeated value).
+//Every 256th value starts a new block with a raw value and a checkpoint, so Get decodes at most one block;
+//iteration decodes sequentially.
+class CompressedFloatList {
+    using Stream = gorilla_detail::BlockStream<gorilla_detail::XorCodec>;
+
+public:
+    static constexpr size_t blockSize = gorilla_detail::blockSize;
+
+    class Iterator {
+    public:
+        Iterator(const Stream* stream, size_t index) : cursor(stream, index) {}
+
+        double operator*() const { return gorilla_detail::FromBits(cursor.Value()); }
+        Iterator& operator++() {
+            cursor.Next();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return cursor.Index() == other.cursor.Index(); }
+        bool operator!=(const Iterator& other) const { return cursor.Index() != other.cursor.Index(); }
+
+    private:
+        Stream::Cursor cursor;
+    };
+
+    size_t Count() const { return stream.Count(); }
+    bool IsEmpty() const { return stream.Count() == 0; }
+    size_t MemoryBytes() const { return stream.MemoryBytes(); }
+
+    void Clear() { stream.Clear(); }
+
+    void Add(double value) { stream.Add(gorilla_detail::ToBits(value)); }
+
+    double operator[](size_t index) const { return gorilla_detail::FromBits(stream.Get(index)); }
+    double Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    //end() doesn't decode anything - iterators compare by index
+    Iterator begin() const { return Iterator(&stream, 0); }
+    Iterator end() const { return Iterator(&stream, Count()); }
+
+    List<double> ToList() const {
+        List<double> list;
+        list.Capacity(Count());
+        for (double value : *this) list.Add(value);
+        return list;
+    }
+
+private:
+    Stream stream;
+};
+
+//Timestamp companion for CompressedFloatList: delta-of-delta encoding, 1 bit per sample at a steady interval
+class CompressedTimestampList {
+    using Stream = gorilla_detail::BlockStream<gorilla_detail::DeltaOfDeltaCodec>;
+
+public:
+    static constexpr size_t blockSize = gorilla_detail::blockSize;
+
+    class Iterator {
+    public:
+        Iterator(const Stream* stream, size_t index) : cursor(stream, index) {}
+
+        int64_t operator*() const { return int64_t(cursor.Value()); }
+        Iterator& operator++() {
+            cursor.Next();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return cursor.Index() == other.cursor.Index(); }
+        bool operator!=(const Iterator& other) const { return cursor.Index() != other.cursor.Index(); }
+
+    private:
+        Stream::Cursor cursor;
+    };
+
+    size_t Count() const { return stream.Count(); }
+    bool IsEmpty() const { return stream.Count() == 0; }
+    size_t MemoryBytes() const { return stream.MemoryBytes(); }
+
+    void Clear() { stream.Clear(); }
+
+    void Add(int64_t timestamp) { stream.Add(uint64_t(timestamp)); }
+
+    int64_t operator[](size_t index) const { return int64_t(stream.Get(index)); }
+    int64_t Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    Iterator begin() const { return Iterator(&stream, 0); }
+    Iterator end() const { return Iterator(&stream, Count()); }
+
+    List<int64_t> ToList() const {
+        List<int64_t> list;
+        list.Capacity(Count());
+        for (int64_t value : *this) list.Add(value);
+        return list;
+    }
+
+private:
+    Stream stream;
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#include "list.h"
+
+//Copy-on-write wrapper around List: copies share one reference-counted buffer (O(1), no allocation),
+//and a handle only deep-copies the buffer the first time it is mutated while shared.
+//The reference count is atomic, so copies can be handed to other threads - each handle itself is not thread-safe.
+//Note: references/pointers obtained from a shared handle are invalidated by the next mutating call on that handle.
+//Handing out a mutable reference/pointer (non-const operator[], Get, begin, end) marks the buffer unshareable: later copies
+//of that handle deep-copy instead of sharing, so writes through the reference can't show up in them. The next mutating
+//call invalidates those references, so it makes the buffer shareable again.
+template <typename T, typename Allocator = std::allocator<T>>
+class CowList {
+public:
+    CowList() : buffer(nullptr) {
+
+    }
+
+    CowList(Allocator const& alloc) : buffer(new Buffer(List<T, Allocator>(alloc))) {
+
+    }
+
+    //Takes a copy (or ownership, if moved in) of an existing List
+    CowList(const List<T, Allocator>& list) : buffer(new Buffer(list)) {}
+    CowList(List<T, Allocator>&& list) : buffer(new Buffer(std::move(list))) {}
+
+    friend void swap(CowList& first, CowList& second) noexcept {
+        std::swap(first.buffer, second.buffer);
+    }
+
+    //Rule of 3
+    ~CowList() {
+        Release();
+    }
+
+    //Copy Constructor - shares the buffer, nothing is copied until one of the handles is mutated
+    //(unless a mutable reference into it was handed out - then it's deep-copied right away)
+    CowList(const CowList& other) : buffer(other.buffer) {
+        if (buffer == nullptr) return;
+        if (buffer->unshareable) buffer = new Buffer(other.buffer->list);
+        else buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CowList& operator=(const CowList& other) {
+        CowList tmp(other);
+        swap(*this, tmp);
+        return *this;
+    }
+
+    //Rule of 5
+    CowList(CowList&& other) noexcept : buffer(other.buffer) {
+        other.buffer = nullptr;
+    }
+    CowList& operator=(CowList&& other) noexcept {
+        CowList tmp(std::move(other));
+        swap(*this, tmp);
+        return *this;
+    }
+
+
+    //Amount of handles sharing this buffer (0 for an empty default-constructed handle)
+    size_t UseCount() const { return buffer != nullptr ? buffer->refs.load(std::memory_order_acquire) : 0; }
+    bool IsShared() const { return UseCount() > 1; }
+
+    //Read-only access to the underlying List, never copies
+    const List<T, Allocator>& View() const { return buffer != nullptr ? buffer->list : Empty(); }
+
+    //Detached copy of the underlying List
+    List<T, Allocator> ToList() const { return View(); }
+
+
+    size_t Capacity() const { return View().Capacity(); }
+    size_t Count() const { return View().Count(); }
+
+    void Clear() {
+        if (IsShared()) { //no need to copy elements that are about to be destroyed
+            CowList tmp(View().GetAllocator());
+            swap(*this, tmp);
+            return;
+        }
+        if (buffer != nullptr) {
+            buffer->list.Clear();
+            buffer->unshareable = false;
+        }
+    }
+
+    void ShrinkToFit() { Mutable().ShrinkToFit(); }
+    void Capacity(size_t new_capacity) { Mutable().Capacity(new_capacity); }
+
+    void Print() const { View().Print(); }
+
+    template<typename... Args>
+    void Add(Args&&... args) {
+        Mutable().Add(std::forward<Args>(args)...);
+    }
+
+    const T* Find(const T& val) const { return View().Find(val); }
+
+    template <typename Predicate>
+    const T* FindIf(Predicate&& pred) const { return View().FindIf(std::forward<Predicate>(pred)); }
+
+    void RemoveAt(size_t index) {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
+        Mutable().RemoveAt(index);
+    }
+
+    size_t Remove(const T& val) {
+        return RemoveIf([&](const auto& e) { return e == val; });
+    }
+
+    //Only detaches if something will actually be removed - the shared scan finds the first match, the compaction starts right after it
+    //so pred still runs once per element
+    template <typename Predicate>
+    size_t RemoveIf(Predicate&& pred) {
+        const T* found = View().FindIf(pred);
+        if (found == nullptr) return 0;
+        const size_t first = size_t(found - View().begin());
+
+        List<T, Allocator>& list = Mutable();
+        T* placer = list.begin() + first;
+        for (T* picker = placer + 1; picker < list.end(); ++picker) {
+            if (!pred(*picker)) {
+                *placer = std::move(*picker);
+                ++placer;
+            }
+        }
+
+        const size_t removed = size_t(list.end() - placer);
+        list.RemoveRange(size_t(placer - list.begin()), list.Count());
+        return removed;
+    }
+
+    const T& operator[](size_t index) const { return View()[index]; } //read-only, never copies
+    T& operator[](size_t index) { return Unshareable()[index]; } //detaches if shared
+    const T& Get(size_t index) const { return View().Get(index); }
+    T& Get(size_t index) {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+        return Unshareable().Get(index);
+    }
+
+
+    //non-const iteration detaches (elements may be written through it) - use cbegin/cend or a const handle for shared reads
+    T* begin() { return Unshareable().begin(); }
+    const T* begin() const { return View().begin(); }
+    const T* cbegin() const { return View().cbegin(); }
+
+    T* end() { return Unshareable().end(); }
+    const T* end() const { return View().end(); }
+    const T* cend() const { return View().cend(); }
+
+
+
+private:
+    struct Buffer {
+        std::atomic<size_t> refs;
+        bool unshareable; //only ever set while refs == 1, and only read by copies of the owning handle
+        List<T, Allocator> list;
+
+        Buffer(const List<T, Allocator>& list) : refs(1), unshareable(false), list(list) {}
+        Buffer(List<T, Allocator>&& list) : refs(1), unshareable(false), list(std::move(list)) {}
+    };
+
+    Buffer* buffer;
+
+    static const List<T, Allocator>& Empty() {
+        static const List<T, Allocator> empty;
+        return empty;
+    }
+
+    void Release() {
+        //acq_rel: the last owner must see every write made by the other owners before deleting
+        if (buffer != nullptr && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete buffer;
+        }
+        buffer = nullptr;
+    }
+
+    //Returns a List only this handle owns, deep-copying the shared buffer on first mutation
+    List<T, Allocator>& Mutable() {
+        if (buffer == nullptr) {
+            buffer = new Buffer(List<T, Allocator>());
+        }
+        else if (buffer->refs.load(std::memory_order_acquire) != 1) {
+            Buffer* detached = new Buffer(buffer->list);
+            Release();
+            buffer = detached;
+        }
+        buffer->unshareable = false; //the mutation invalidates references handed out earlier, so the buffer can be shared again
+        return buffer->list;
+    }
+
+    //Mutable(), for callers that hand out references/pointers into the buffer
+    List<T, Allocator>& Unshareable() {
+        List<T, Allocator>& list = Mutable();
+        buffer->unshareable = true;
+        return list;
+    }
+};
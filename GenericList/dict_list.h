@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "list.h"
+#include "bit_list.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define DICT_LIST_SSE2 1
+#include <emmintrin.h>
+#else
+#define DICT_LIST_SSE2 0
+#endif
+
+//Dictionary encoded List for low-cardinality columns (a few hundred distinct strings repeated millions of times):
+//each distinct value is stored once, elements are uint32_t codes into the dictionary.
+//Equality lookups probe the dictionary once and then scan the codes as integers, RemoveIf calls the predicate once
+//per dictionary entry instead of once per element. Elements are decoded on access/iteration (a const T&, no copy).
+//Dictionary entries are kept after their last element is removed, so re-adding the value doesn't allocate.
+template <typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+class DictList {
+public:
+    static constexpr size_t npos = size_t(-1);
+
+    class Iterator {
+    public:
+        Iterator(const DictList* list, const uint32_t* code) : list(list), code(code) {}
+
+        const T& operator*() const { return *list->values[*code]; }
+        Iterator& operator++() {
+            ++code;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return code == other.code; }
+        bool operator!=(const Iterator& other) const { return code != other.code; }
+
+    private:
+        const DictList* list;
+        const uint32_t* code;
+    };
+
+    DictList() {
+
+    }
+
+    //values points at the map's keys, which stay put - copies rebuild it against their own map
+    DictList(const DictList& other) : lookup(other.lookup), codes(other.codes) {
+        RebuildValues();
+    }
+    DictList(DictList&& other) noexcept = default;
+    DictList& operator=(DictList other) noexcept {
+        using std::swap;
+        swap(lookup, other.lookup);
+        swap(values, other.values);
+        swap(codes, other.codes);
+        return *this;
+    }
+
+
+    size_t Count() const { return codes.Count(); }
+    bool IsEmpty() const { return codes.Count() == 0; }
+    //Distinct values seen so far
+    size_t DictionarySize() const { return values.Count(); }
+
+    void Clear() {
+        lookup.clear();
+        values.Clear();
+        codes.Clear();
+    }
+
+    void Add(const T& value) {
+        codes.Add(Intern(value));
+    }
+
+    const T& operator[](size_t index) const { return *values[codes[index]]; }
+    const T& Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    //The encoded elements and the dictionary they index into
+    const List<uint32_t>& Codes() const { return codes; }
+    const T& Decode(uint32_t code) const { return *values.Get(code); }
+
+    //Code of val, npos if it was never added
+    size_t CodeOf(const T& val) const {
+        auto found = lookup.find(val);
+        return found != lookup.end() ? found->second : npos;
+    }
+
+    //Index of the first element equal to val, npos if none
+    size_t Find(const T& val) const {
+        const size_t code = CodeOf(val);
+        return code != npos ? FindCode(uint32_t(code)) : npos;
+    }
+
+    bool Contains(const T& val) const {
+        return Find(val) != npos;
+    }
+
+    size_t CountOf(const T& val) const {
+        const size_t code = CodeOf(val);
+        if (code == npos) return 0;
+        size_t n = 0;
+        for (uint32_t c : codes) n += c == code;
+        return n;
+    }
+
+    void RemoveAt(size_t index) {
+        codes.RemoveAt(index);
+    }
+
+    //Removes every element equal to val, returns how many were removed
+    size_t Remove(const T& val) {
+        const size_t code = CodeOf(val);
+        if (code == npos) return 0;
+        const uint32_t target = uint32_t(code);
+        return codes.RemoveIf([target](uint32_t c) { return c == target; });
+    }
+
+    //pred runs once per dictionary entry, the codes are then compacted against the resulting mask
+    template <typename Predicate>
+    size_t RemoveIf(Predicate&& pred) {
+        BitList removed;
+        for (const T* value : values) removed.Add(bool(pred(*value)));
+        if (removed.CountSet() == 0) return 0;
+        return codes.RemoveIf([&](uint32_t c) { return removed[c]; });
+    }
+
+    Iterator begin() const { return Iterator(this, codes.begin()); }
+    Iterator end() const { return Iterator(this, codes.end()); }
+
+    List<T> ToList() const {
+        List<T> list;
+        list.Capacity(Count());
+        for (uint32_t c : codes) list.Add(*values[c]);
+        return list;
+    }
+
+private:
+    std::unordered_map<T, uint32_t, Hash, Equal> lookup;
+    List<const T*> values; //code -> value (a key of lookup)
+    List<uint32_t> codes;
+
+    uint32_t Intern(const T& value) {
+        auto inserted = lookup.emplace(value, uint32_t(values.Count()));
+        if (inserted.second) values.Add(&inserted.first->first);
+        return inserted.first->second;
+    }
+
+    void RebuildValues() {
+        values.Clear();
+        values.Capacity(lookup.size());
+        for (size_t i = 0; i < lookup.size(); i++) values.Add(nullptr);
+        for (const auto& entry : lookup) values[entry.second] = &entry.first;
+    }
+
+    //Index of the first code equal to target - compares 4 codes per step where SSE2 is available
+    size_t FindCode(uint32_t target) const {
+        const uint32_t* data = codes.begin();
+        const size_t n = codes.Count();
+        size_t i = 0;
+#if DICT_LIST_SSE2
+        const __m128i key = _mm_set1_epi32(int(target));
+        for (; i + 16 <= n; i += 16) {
+            //4 vectors per step keeps the loop on one movemask per 16 codes
+            const __m128i* block = reinterpret_cast<const __m128i*>(data + i);
+            const __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128(block), key);
+            const __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128(block + 1), key);
+            const __m128i eq2 = _mm_cmpeq_epi32(_mm_loadu_si128(block + 2), key);
+            const __m128i eq3 = _mm_cmpeq_epi32(_mm_loadu_si128(block + 3), key);
+            const __m128i any = _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+            if (_mm_movemask_epi8(any) != 0) break;
+        }
+#endif
+        for (; i < n; i++) {
+            if (data[i] == target) return i;
+        }
+        return npos;
+    }
+};
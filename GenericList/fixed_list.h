@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <initializer_list>
+
+#include "list.h"
+
+//Fixed-capacity list stored inline (no allocation): at most N elements in an array, plus a count.
+//It's a literal type, so a constexpr FixedList is a compile-time table that ends up in read-only data.
+//The usual way to fill one is to build a List in constant evaluation (C++20) and copy it with ToFixedList:
+//    constexpr List<int> Primes() { List<int> p; ...; return p; }
+//    constexpr auto primes = ToFixedList<Primes().Count()>(Primes());
+//C++17 can still fill one in a constexpr function/lambda through Add.
+template <typename T, size_t N>
+class FixedList {
+    static_assert(!std::is_reference_v<T>, "reference type is not allowed");
+    static_assert(std::is_default_constructible_v<T>, "FixedList value-initializes its whole array");
+
+public:
+    constexpr FixedList() : values{}, count(0) {
+
+    }
+
+    constexpr FixedList(std::initializer_list<T> init) : values{}, count(0) {
+        for (const T& val : init) Add(val);
+    }
+
+
+    constexpr size_t Count() const { return count; }
+    static constexpr size_t Capacity() { return N; }
+    constexpr bool IsEmpty() const { return count == 0; }
+
+    constexpr void Add(const T& val) {
+        if (count == N) throw std::length_error(std::string("Cannot add to a full FixedList of capacity: ") + std::to_string(N) + std::string("."));
+
+        values[count++] = val;
+    }
+
+    constexpr const T& operator[](size_t index) const { return values[index]; }
+    constexpr T& operator[](size_t index) { return values[index]; }
+    constexpr const T& Get(size_t index) const {
+        if (index >= count) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return values[index];
+    }
+
+    template <typename U>
+    constexpr const T* Find(const U& val) const {
+        for (size_t i = 0; i < count; i++) {
+            if (values[i] == val) return values + i;
+        }
+        return nullptr;
+    }
+
+    template <typename Predicate>
+    constexpr const T* FindIf(Predicate&& pred) const {
+        for (auto ptr = begin(); ptr < end(); ptr++) {
+            if (pred(*ptr)) return ptr;
+        }
+        return nullptr;
+    }
+
+    template <typename U>
+    constexpr bool Contains(const U& val) const { return Find(val) != nullptr; }
+
+    //Index of the first element not less than val - the table must be sorted (eg: built with List::Sort)
+    template <typename U>
+    constexpr size_t LowerBound(const U& val) const {
+        size_t first = 0;
+        size_t len = count;
+        while (len > 0) {
+            const size_t half = len / 2;
+            if (values[first + half] < val) {
+                first += half + 1;
+                len -= half + 1;
+            }
+            else {
+                len = half;
+            }
+        }
+        return first;
+    }
+
+    //Runtime copy into a growable List
+    List<T> ToList() const {
+        List<T> list;
+        list.AddRange(begin(), end());
+        return list;
+    }
+
+
+    constexpr const T* begin() const { return values; }
+    constexpr T* begin() { return values; }
+    constexpr const T* end() const { return values + count; }
+    constexpr T* end() { return values + count; }
+
+private:
+    T values[N];
+    size_t count;
+};
+
+
+//Copies list into a FixedList - constexpr under C++20, where list may be a List built during the same constant evaluation
+template <size_t N, typename T, typename Allocator>
+LIST_CONSTEXPR FixedList<T, N> ToFixedList(const List<T, Allocator>& list) {
+    if (list.Count() > N) throw std::length_error(std::string("Cannot fit ") + std::to_string(list.Count()) + std::string(" elements in a FixedList of capacity: ") + std::to_string(N) + std::string("."));
+
+    FixedList<T, N> fixed;
+    for (const T& val : list) fixed.Add(val);
+    return fixed;
+}
@@ -3,17 +3,51 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <cassert>
 #include <functional>
 #include <algorithm>
 #include <type_traits>
+#include <iterator>
+#include <initializer_list>
+#include <unordered_set>
+#include <cstring>
+#include <cstdint>
 
 // Never use header-wide using directives ("using namespace") in the header!!
 // Explanation: https://stackoverflow.com/questions/5849457/using-namespace-in-c-headers
 // Basically, when this header is included, the "using namespace" will be included too, possibly causing un-intended clashes in variable/function/etc.. namess
 // Note: as long as code doesn't #include a .cpp file, it's fine to use using directives in that source file
 
+//How bulk operations (lazy pipelines, reductions, sorting) run over the elements
+enum class LazyExecution {
+    Sequential,
+    Parallel //chunk-parallel: one chunk per hardware thread, results are kept in element order - callbacks must be safe to call concurrently
+};
+
+//C++20: the core of List (construction, Add, Resize, Find, Sort, RemoveAt, iteration) is usable in constant evaluation.
+//Allocations are transient - a List can't outlive the constant expression, copy it into a FixedList (see fixed_list.h) instead.
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define LIST_HAS_CONSTEXPR 1
+#define LIST_CONSTEXPR constexpr
+#else
+#define LIST_HAS_CONSTEXPR 0
+#define LIST_CONSTEXPR
+#endif
+
+//Declared here for List::Lazy(), defined in list_pipeline.h (included at the end of this file)
+namespace lazy_detail { struct IdentityStage; }
+template <typename T, typename Stage>
+class LazyList;
+
+//Declared here for List::Sort(), defined in list_sort.h (included at the end of this file)
+template <typename T>
+struct ListSort;
+
+//Declared here for List::MatchMask(), defined in bit_list.h (included at the end of this file)
+class BitList;
+
 //Generic type, allow for stateful Allocator if user desires it
 template <typename T, typename Allocator = std::allocator<T>>
 class List {
@@ -22,17 +56,23 @@ class List {
     //C++ Standard 8.3.2/4: There shall be no references to references, no arrays of references, and no pointers to references.
 
 
+    //Valid (SFINAE) only if elements can be compared with a K - constrains the heterogeneous Find/Remove/Contains overloads
+    //Arithmetic elements keep the const T& overloads, so mixed arithmetic keys are still converted to T before comparing
+    template <typename K>
+    using IsComparable = std::enable_if_t<!std::is_arithmetic_v<T>, decltype(std::declval<const T&>() == std::declval<const K&>())>;
+
+
     //note: elements are value copies of original objects (copy-by-value, not copy-by-reference)
 public:
-    List() : dataAllocator(), data(nullptr), capacity(0), count(0) {
+    LIST_CONSTEXPR List() : dataAllocator(), data(nullptr), capacity(0), count(0) {
 
     }
 
-    List(Allocator const& alloc) : dataAllocator(alloc), data(nullptr), capacity(0), count(0) {
+    LIST_CONSTEXPR List(Allocator const& alloc) : dataAllocator(alloc), data(nullptr), capacity(0), count(0) {
     
     }
 
-    friend void swap(List& first, List& second) noexcept {
+    LIST_CONSTEXPR friend void swap(List& first, List& second) noexcept {
         //Purely swap data: since we want the states to remain the same as beforehand, just switched, explicitely use std::swap in case swap(Allocator&, Allocator&) somehow moves memory around
         //Note: since data is a pointer value, it cannot have a "custom swap friend function" - aka, let's just use std::swap everywhere
         std::swap(first.dataAllocator, second.dataAllocator);
@@ -42,24 +82,24 @@ public:
     }
 
     //Rule of 3
-    ~List() { //Destructor
+    LIST_CONSTEXPR ~List() { //Destructor
         Clear();
-        dataAllocator.deallocate(data, capacity);
+        if (data != nullptr) dataAllocator.deallocate(data, capacity);
     }
 
     //Copy Constructor - dataAllocator is not copied over as the data allocated is not the same (different memory address, deep copy)
     //TODO: look into std::allocator_traits
-    List(const List& other) : dataAllocator(other.dataAllocator), data(CreateDeepCopy(other, dataAllocator)),
+    LIST_CONSTEXPR List(const List& other) : dataAllocator(other.dataAllocator), data(CreateDeepCopy(other, dataAllocator)),
                               capacity(other.capacity), count(other.count) {}
 
-    List& operator=(const List& other) { //Copy assignement - keep dataAllocator the same as it was
+    LIST_CONSTEXPR List& operator=(const List& other) { //Copy assignement - keep dataAllocator the same as it was
         if (this != &other) {
             Clear();
             Capacity(other.capacity);
             const auto end = other.data + other.count;
             //double-pointer progression
             for (auto dst = data, src = other.data; src != end; ++src, ++dst) {
-                new (dst) T(*src);
+                Construct(dst, *src);
             }
             count = other.count;
         }
@@ -69,13 +109,13 @@ public:
     //Rule of 5
     //R-value references (&&) explained: http://thbecker.net/articles/rvalue_references/section_01.html 
     //basic explanation: if a function argument is &&, whatever it references will stop existing at the end of the function
-    List(List&& other) noexcept : dataAllocator(std::move(other.dataAllocator)), data(other.data), capacity(other.capacity), count(other.count) {
+    LIST_CONSTEXPR List(List&& other) noexcept : dataAllocator(std::move(other.dataAllocator)), data(other.data), capacity(other.capacity), count(other.count) {
         //due to using std::move(other.dataAllocator), other.dataAllocator is now unrelated to *this.dataAllocator (and *this.dataAllocated retains all previous info)
         other.data = nullptr;
         other.capacity = 0;
         other.count = 0;
     }
-    List& operator=(List&& other) noexcept { 
+    LIST_CONSTEXPR List& operator=(List&& other) noexcept { 
         List tmp(std::move(other));
         swap(*this, tmp);
         return *this;
@@ -84,7 +124,7 @@ public:
 
 
     //Remove all elements - maintain capacity
-    void Clear() {
+    LIST_CONSTEXPR void Clear() {
         for (size_t i = 0; i < count; i++) {
             data[i].~T();
         }
@@ -92,17 +132,18 @@ public:
     }
 
     //Shrink array capacity down to count
-    void ShrinkToFit() {
+    LIST_CONSTEXPR void ShrinkToFit() {
         if (capacity == count) return;
         //sadly, allocators don't support partial deallocation - need to fully resize
         Resize(count);
     }
 
-    size_t Capacity() const { return capacity; }
-    size_t Count() const { return count; }
+    LIST_CONSTEXPR size_t Capacity() const { return capacity; }
+    LIST_CONSTEXPR size_t Count() const { return count; }
+    Allocator GetAllocator() const { return dataAllocator; }
 
     //Sets the capacity of the internal array to new_capacity. If new_capacity is smaller than Count, do nothing.
-    void Capacity(size_t new_capacity) {
+    LIST_CONSTEXPR void Capacity(size_t new_capacity) {
         if (new_capacity <= capacity) return; //no change
         Resize(new_capacity);
     }
@@ -118,26 +159,58 @@ public:
 
     //Take in any amount of arguments of any type, then unpack on element construction - allows for creating new data without checking for logic errors (the compiler and the element's constructor will take care of that)
     template<typename... Args>
-    void Add(Args&&... args) {
+    LIST_CONSTEXPR void Add(Args&&... args) {
         if (capacity == count) Capacity(std::max(size_t(2) * capacity, size_t(1)));
-        new (data + count++) T(std::forward<Args>(args)...);
+        Construct(data + count++, std::forward<Args>(args)...);
     }
 
-    T* Find(const T& val) {
-        for (size_t i = 0; i < count; i++) {
-            if (data[i] == val) return data + i; //TODO: research why &data[i] might get overloaded
+    //Copies [first, last) to the end of the list, growing the capacity at most once
+    void AddRange(const T* first, const T* last) {
+        const size_t amount = size_t(last - first);
+        if (count + amount > capacity) {
+            //first/last may point into this list - remember where before reallocating
+            const bool inside = first >= data && first < data + count;
+            const size_t offset = inside ? size_t(first - data) : 0;
+            Capacity(std::max(size_t(2) * capacity, count + amount));
+            if (inside) first = data + offset;
         }
-        return nullptr;
-    }
-    const T* Find(const T& val) const {
-        for (size_t i = 0; i < count; i++) {
-            if (data[i] == val) return data + i; //TODO: research why &data[i] might get overloaded
+
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (amount > 0) std::memcpy(static_cast<void*>(data + count), first, amount * sizeof(T));
         }
-        return nullptr;
+        else {
+            for (size_t i = 0; i < amount; i++) {
+                Construct(data + count + i, first[i]);
+            }
+        }
+        count += amount;
     }
 
+    //Appends amount elements left uninitialized (trivially copyable T only), returning the first - the caller fills them in, eg: with bulk reads
+    T* AddUninitialized(size_t amount) {
+        static_assert(std::is_trivially_copyable<T>::value, "AddUninitialized requires a trivially copyable element type");
+        if (count + amount > capacity) Capacity(std::max(size_t(2) * capacity, count + amount));
+
+        T* first = data + count;
+        count += amount;
+        return first;
+    }
+
+    LIST_CONSTEXPR T* Find(const T& val) { return FindIf(EqualTo(val)); }
+    LIST_CONSTEXPR const T* Find(const T& val) const { return FindIf(EqualTo(val)); }
+
+    //Heterogeneous lookup: any key comparable with T (eg: const char*/std::string_view for List<std::string>) without building a temporary T
+    template <typename K, typename = IsComparable<K>>
+    LIST_CONSTEXPR T* Find(const K& val) { return FindIf(EqualTo(val)); }
+    template <typename K, typename = IsComparable<K>>
+    LIST_CONSTEXPR const T* Find(const K& val) const { return FindIf(EqualTo(val)); }
+
+    LIST_CONSTEXPR bool Contains(const T& val) const { return Find(val) != nullptr; }
+    template <typename K, typename = IsComparable<K>>
+    LIST_CONSTEXPR bool Contains(const K& val) const { return Find(val) != nullptr; }
+
     template <typename Predicate>
-    T* FindIf(Predicate&& pred) {
+    LIST_CONSTEXPR T* FindIf(Predicate&& pred) {
         for (auto ptr = begin(); ptr < end(); ptr++) {
             if (pred(*ptr)) return ptr; //TODO: research why &data[i] might get overloaded
         }
@@ -145,29 +218,75 @@ public:
     }
 
     template <typename Predicate>
-    const T* FindIf(Predicate&& pred) const {
+    LIST_CONSTEXPR const T* FindIf(Predicate&& pred) const {
         for (auto ptr = begin(); ptr < end(); ptr++) {
             if (pred(*ptr)) return ptr; //TODO: research why &data[i] might get overloaded
         }
         return nullptr;
     }
 
-    void RemoveAt(size_t index) {
+    //Indices of every element matching pred, in one pass (feed them to RemoveAtMany, or gather with them)
+    template <typename Predicate>
+    LIST_CONSTEXPR List<size_t> FindAll(Predicate&& pred) const {
+        List<size_t> indices;
+        for (size_t i = 0; i < count; i++) {
+            if (pred(data[i])) indices.Add(i);
+        }
+        return indices;
+    }
+
+    template <typename Predicate>
+    LIST_CONSTEXPR size_t CountIf(Predicate&& pred) const {
+        size_t n = 0;
+        for (auto ptr = begin(); ptr < end(); ptr++) {
+            n += size_t(bool(pred(*ptr)));
+        }
+        return n;
+    }
+
+    //Mask with flag i set if pred(element i) (feed it to RemoveByMask, or combine masks with &, |, ^).
+    //Flags are packed 64 to a word without branches, so simple predicates over arithmetic elements can be vectorized.
+    template <typename Mask = BitList, typename Predicate>
+    Mask MatchMask(Predicate&& pred) const {
+        Mask mask;
+        size_t i = 0;
+        for (; i + 64 <= count; i += 64) {
+            uint64_t word = 0;
+            for (size_t j = 0; j < 64; j++) {
+                word |= uint64_t(bool(pred(data[i + j]))) << j;
+            }
+            mask.AddWord(word, 64);
+        }
+
+        uint64_t word = 0;
+        for (size_t j = 0; i + j < count; j++) {
+            word |= uint64_t(bool(pred(data[i + j]))) << j;
+        }
+        if (i < count) mask.AddWord(word, count - i);
+        return mask;
+    }
+
+    LIST_CONSTEXPR void RemoveAt(size_t index) {
         if (index < 0 || index >= count) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
 
         std::move(data + index + 1, data + count, data + index);
-        data[--count].~T();
+        --count; //kept out of the destructor call: GCC drops side effects of a scalar pseudo-destructor's operand in constant evaluation
+        data[count].~T();
     }
 
 
     //Returns true if a relevant element exists, and removes it.
-    size_t Remove(const T& val) {
+    LIST_CONSTEXPR size_t Remove(const T& val) {
         //Lazy, simpler way - when changing behaviour, just change it in RemoveIf:
-        return RemoveIf([&](const auto& e) { return e == val; } );
+        return RemoveIf(EqualTo(val));
+    }
+    template <typename K, typename = IsComparable<K>>
+    LIST_CONSTEXPR size_t Remove(const K& val) {
+        return RemoveIf(EqualTo(val));
     }
     
     template <typename Predicate>
-    size_t RemoveIf(Predicate&& pred) {
+    LIST_CONSTEXPR size_t RemoveIf(Predicate&& pred) {
         //idea: double pointers, picker points to next element to check,
         //                       placer points to next available space
 
@@ -181,52 +300,234 @@ public:
             }
         }
 
-        //if constexpr is evaluated at compile time - eg: List<int> won't have the following code when compiled
-        if constexpr (!std::is_trivially_destructible<T>::value) { //those that are don't have non-empty destructors to call
-            for (auto k = placer; k < end(); ++k) {
-                k->~T(); //destructs meaningless data from matched indexes moved to end
+        return DestroyTail(placer);
+    }
+
+    //Order-breaking variants of RemoveAt/Remove/RemoveIf: holes are filled with elements taken from the back of the list,
+    //so each removed element costs at most one move instead of shifting the whole tail (use when order doesn't matter, eg: work queues)
+    void RemoveAtUnordered(size_t index) {
+        if (index >= count) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        if (index != count - 1) data[index] = std::move(data[count - 1]);
+        data[--count].~T();
+    }
+
+    size_t RemoveUnordered(const T& val) {
+        return RemoveIfUnordered(EqualTo(val));
+    }
+    template <typename K, typename = IsComparable<K>>
+    size_t RemoveUnordered(const K& val) {
+        return RemoveIfUnordered(EqualTo(val));
+    }
+
+    template <typename Predicate>
+    size_t RemoveIfUnordered(Predicate&& pred) {
+        //idea: double pointers converging from both ends, placer points to next hole (matching element) from the front,
+        //                                                 last points one past the last element that is still kept
+        //each element is checked exactly once, and each hole is filled by a single move from the back
+        auto placer = begin();
+        auto last = end();
+
+        while (true) {
+            while (placer < last && !pred(*placer)) ++placer;
+            if (placer == last) break;
+
+            do { --last; } while (last > placer && pred(*last));
+            if (last == placer) break;
+
+            *placer = std::move(*last); //*last now contains irrelevant instantiated data, and is past the kept range
+            ++placer;
+        }
+
+        return DestroyTail(last);
+    }
+
+    //Removes the elements in [first, last) with a single shift of the tail
+    void RemoveRange(size_t first, size_t last) {
+        if (first > last || last > count) throw std::out_of_range(std::string("Cannot remove out_of_range range: [") + std::to_string(first) + std::string(", ") + std::to_string(last) + std::string(")."));
+        if (first == last) return;
+
+        auto placer = std::move(data + last, data + count, data + first);
+        DestroyTail(placer);
+    }
+
+    //Removes every element whose index is in indices (any order, duplicates allowed) in a single compaction pass.
+    //Throws, without removing anything, if any index is out of range. Returns the amount of elements removed.
+    template <typename Indices>
+    size_t RemoveAtMany(const Indices& indices) {
+        using std::begin;
+        using std::end;
+        auto first = begin(indices);
+        auto last = end(indices);
+        if (first == last) return 0;
+
+        //compaction needs strictly increasing indices - only pay for a sorted copy if the caller didn't already provide one
+        if (std::adjacent_find(first, last, [](size_t a, size_t b) { return a >= b; }) != last) {
+            List<size_t> sorted;
+            sorted.Capacity(size_t(std::distance(first, last)));
+            for (auto it = first; it != last; ++it) sorted.Add(size_t(*it));
+            std::sort(sorted.begin(), sorted.end());
+            sorted.RemoveRange(size_t(std::unique(sorted.begin(), sorted.end()) - sorted.begin()), sorted.Count());
+            return RemoveAtSorted(sorted.begin(), sorted.end());
+        }
+        return RemoveAtSorted(first, last);
+    }
+    size_t RemoveAtMany(std::initializer_list<size_t> indices) {
+        return RemoveAtMany<std::initializer_list<size_t>>(indices);
+    }
+
+    //Removes every element at index i for which mask[i] is true, in a single compaction pass.
+    //mask can be any indexable type (List<bool>, std::vector<bool>, BitList, ...) and must cover at least Count() elements.
+    //Masks with a FindNextSet(index) member (BitList) skip the leading unset flags a word at a time.
+    template <typename Mask>
+    size_t RemoveByMask(const Mask& mask) {
+        size_t first = 0;
+        if constexpr (HasFindNextSet<Mask>::value) {
+            first = std::min(mask.FindNextSet(0), count);
+        }
+        else {
+            while (first < count && !mask[first]) ++first;
+        }
+        if (first == count) return 0;
+
+        return RemoveIndexIf(first, [&](size_t index) { return bool(mask[index]); });
+    }
+
+    //Removes consecutive duplicates (each element equal to the last kept one), like std::unique - on a sorted list this removes all duplicates
+    template <typename Equal = std::equal_to<>>
+    size_t Unique(Equal&& equal = Equal()) {
+        size_t first = 1;
+        while (first < count && !equal(data[first - 1], data[first])) ++first;
+        if (first >= count) return 0;
+
+        auto placer = data + first;
+        for (auto picker = placer + 1; picker < end(); ++picker) {
+            if (!equal(*(placer - 1), *picker)) {
+                *placer = std::move(*picker);
+                ++placer;
             }
         }
 
-        const auto removed = end() - placer;
-        count -= removed;
+        return DestroyTail(placer);
+    }
 
-        return removed;
+    //Removes every element equal to an earlier one, keeping the first occurrences in their original order (no sorting needed).
+    //Hashes element addresses, so nothing is copied into the set.
+    template <typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+    size_t Dedup(Hash hash = Hash(), Equal equal = Equal()) {
+        auto hashPtr = [&](const T* e) { return hash(*e); };
+        auto equalPtr = [&](const T* a, const T* b) { return equal(*a, *b); };
+        std::unordered_set<const T*, decltype(hashPtr), decltype(equalPtr)> seen(count, hashPtr, equalPtr);
+
+        List<bool> duplicates;
+        duplicates.Capacity(count);
+        for (size_t i = 0; i < count; i++) {
+            duplicates.Add(!seen.insert(data + i).second);
+        }
+
+        return RemoveByMask(duplicates);
     }
 
-    const T& operator[](size_t index) const { return data[index]; } //read-only
-    T& operator[](size_t index) { return data[index]; } //read+(later)write
-    const T& Get(size_t index) const {
+    LIST_CONSTEXPR const T& operator[](size_t index) const { return data[index]; } //read-only
+    LIST_CONSTEXPR T& operator[](size_t index) { return data[index]; } //read+(later)write
+    LIST_CONSTEXPR const T& Get(size_t index) const {
         if (index >= count || index < 0) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
 
         return data[index];
     }
-    T& Get(size_t index) {
+    LIST_CONSTEXPR T& Get(size_t index) {
         if (index >= count || index < 0) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
 
         return data[index];
     }
 
 
+    //Sorts in ascending order - arithmetic types up to 64 bits use a radix sort (see list_sort.h) that can run chunk-parallel
+    LIST_CONSTEXPR void Sort(LazyExecution execution = LazyExecution::Sequential) {
+#if LIST_HAS_CONSTEXPR
+        if (std::is_constant_evaluated()) return std::sort(begin(), end()); //radix buffers and threads aren't available at compile time
+#endif
+        if constexpr (std::is_arithmetic_v<T>) {
+            ListSort<T>::Radix(data, count, dataAllocator, execution);
+        }
+        else {
+            Sort(std::less<>());
+        }
+    }
+
+    //Unstable sort by comp (a strict weak ordering, like std::sort) - pattern-defeating quicksort
+    template <typename Compare>
+    LIST_CONSTEXPR void Sort(Compare&& comp) {
+#if LIST_HAS_CONSTEXPR
+        if (std::is_constant_evaluated()) return std::sort(begin(), end(), comp);
+#endif
+        ListSort<T>::Introsort(begin(), end(), comp);
+    }
+
+    //Stable sort by comp: equal elements keep their relative order - merge sort with a buffer from the list's allocator
+    template <typename Compare = std::less<>>
+    void StableSort(Compare&& comp = Compare()) {
+        ListSort<T>::MergeSort(data, count, dataAllocator, comp);
+    }
+
+    //Stable sort by an arithmetic key extracted from each element (eg: [](const Entry& e) { return e.id; }), using a radix sort
+    template <typename KeyFunc>
+    void SortByKey(KeyFunc&& key, LazyExecution execution = LazyExecution::Sequential) {
+        ListSort<T>::RadixByKey(data, count, dataAllocator, key, execution);
+    }
+
+    //Lazy, fused pipeline over the elements (see list_pipeline.h): list.Lazy().Filter(p).Map(f).Collect()
+    LazyList<T, lazy_detail::IdentityStage> Lazy() const { return LazyList<T, lazy_detail::IdentityStage>(begin(), end()); }
+
+
     //can iterate through list without using iterators if internal data is contiguous
-    T* begin() { return data; }
-    const T* begin() const { return data; } //non-copy version for read-only
-    const T* cbegin() const { return data; } //same as above, allows for direct call to cbegin for user who knows they want constant iterators
+    LIST_CONSTEXPR T* begin() { return data; }
+    LIST_CONSTEXPR const T* begin() const { return data; } //non-copy version for read-only
+    LIST_CONSTEXPR const T* cbegin() const { return data; } //same as above, allows for direct call to cbegin for user who knows they want constant iterators
     
-    T* end() { return data + count; }
-    const T* end() const { return data + count; }
-    const T* cend() const { return data + count; }
+    LIST_CONSTEXPR T* end() { return data + count; }
+    LIST_CONSTEXPR const T* end() const { return data + count; }
+    LIST_CONSTEXPR const T* cend() const { return data + count; }
 
 
 
 private:
+    template <typename U>
+    struct IsBasicString : std::false_type {};
+    template <typename Char, typename Traits, typename Alloc>
+    struct IsBasicString<std::basic_string<Char, Traits, Alloc>> : std::true_type {};
+
+    //Equality predicate used by Find/Remove/Contains.
+    //Strings compare against a string_view of the key, built once: length first, then a memcmp of the characters
+    template <typename K>
+    static LIST_CONSTEXPR auto EqualTo(const K& val) {
+        if constexpr (IsBasicString<T>::value) {
+            using View = std::basic_string_view<typename T::value_type, typename T::traits_type>;
+            if constexpr (std::is_convertible_v<const K&, View>) {
+                const View key(val);
+                return [key](const T& e) { return e.size() == key.size() && T::traits_type::compare(e.data(), key.data(), key.size()) == 0; };
+            }
+            else {
+                return [&val](const T& e) { return e == val; };
+            }
+        }
+        else {
+            return [&val](const T& e) { return e == val; };
+        }
+    }
+
+    template <typename Mask, typename = void>
+    struct HasFindNextSet : std::false_type {};
+    template <typename Mask>
+    struct HasFindNextSet<Mask, std::void_t<decltype(std::declval<const Mask&>().FindNextSet(size_t(0)))>> : std::true_type {};
+
     T* data;
     size_t capacity;
     size_t count;
 
     Allocator dataAllocator; //not actually necessary to maintain same allocator throughout program as allocators can allocate/deallocate any data
 
-    static T* CreateDeepCopy(const List& list, Allocator& alloc) {
+    static LIST_CONSTEXPR T* CreateDeepCopy(const List& list, Allocator& alloc) {
         size_t capacity = list.capacity;
         size_t count = list.count;
 
@@ -235,27 +536,89 @@ private:
         T* new_data = capacity > 0 ? alloc.allocate(capacity) : nullptr;
 
         for (size_t i = 0; i < count; i++) {
-            new (new_data + i) T(list[i]);
+            Construct(new_data + i, list[i]);
         }
 
         return new_data;
     }
 
-    void Resize(size_t new_capacity) {
+    //Same picker/placer scheme as RemoveIf, but matching on indexes: first is the index of the first removed element,
+    //and removed(index) is called once for every later index, in increasing order
+    template <typename IndexPredicate>
+    size_t RemoveIndexIf(size_t first, IndexPredicate&& removed) {
+        auto placer = data + first;
+
+        for (size_t picker = first + 1; picker < count; ++picker) {
+            if (!removed(picker)) {
+                *placer = std::move(data[picker]);
+                ++placer;
+            }
+        }
+
+        return DestroyTail(placer);
+    }
+
+    //Removes strictly increasing indices [first, last)
+    template <typename Iterator>
+    size_t RemoveAtSorted(Iterator first, Iterator last) {
+        const size_t maxIndex = size_t(*std::prev(last));
+        if (maxIndex >= count) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(maxIndex) + std::string("."));
+
+        auto next = first;
+        ++next;
+        return RemoveIndexIf(size_t(*first), [&](size_t index) {
+            if (next != last && size_t(*next) == index) {
+                ++next;
+                return true;
+            }
+            return false;
+        });
+    }
+
+    //Destructs the meaningless elements in [newEnd, end()) left behind by a compaction, and returns how many there were
+    LIST_CONSTEXPR size_t DestroyTail(T* newEnd) {
+        //if constexpr is evaluated at compile time - eg: List<int> won't have the following code when compiled
+        if constexpr (!std::is_trivially_destructible<T>::value) { //those that are don't have non-empty destructors to call
+            for (auto k = newEnd; k < end(); ++k) {
+                k->~T(); //destructs meaningless data from matched indexes moved to end
+            }
+        }
+
+        const size_t removed = end() - newEnd;
+        count -= removed;
+
+        return removed;
+    }
+
+    //Placement new isn't allowed in constant evaluation, std::construct_at is
+    template <typename... Args>
+    static LIST_CONSTEXPR void Construct(T* ptr, Args&&... args) {
+#if LIST_HAS_CONSTEXPR
+        std::construct_at(ptr, std::forward<Args>(args)...);
+#else
+        new (ptr) T(std::forward<Args>(args)...);
+#endif
+    }
+
+    LIST_CONSTEXPR void Resize(size_t new_capacity) {
         assert(new_capacity >= count); //asserts get removed in release builds
 
         T* new_data = dataAllocator.allocate(new_capacity);
         const auto end = data + count;
         for (auto dest = new_data, src = data; src != end; ++src, ++dest) {
-            new (dest) T(*src); //move data to new location (also clears data from old location)
+            Construct(dest, std::move(*src)); //move data to new location (also clears data from old location)
             src->~T(); //delete invalid data at old location (does not own any relevant data anymore so can destruct safely)
         }
 
-        dataAllocator.deallocate(data, capacity);
+        if (data != nullptr) dataAllocator.deallocate(data, capacity);
 
         data = new_data;
         capacity = new_capacity;
     }
 
 
-};
\ No newline at end of file
+};
+
+#include "list_pipeline.h"
+#include "list_sort.h"
+#include "bit_list.h"
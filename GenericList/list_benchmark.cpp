@@ -0,0 +1,395 @@
+// ListBenchmark.cpp : This file contains the 'Main_Benchmark_List' function, timing List operations against each other.
+//
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <random>
+
+
+#include "list.h"
+#include "cow_list.h"
+#include "list_reduce.h"
+#include "arena_string_list.h"
+#include "string_search.h"
+#include "dict_list.h"
+#include "packed_int_list.h"
+#include "compressed_float_list.h"
+#include "list_prefetch.h"
+
+
+//Runs func once and returns elapsed time in milliseconds
+template <typename Func>
+double TimeMs(Func&& func) {
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	const auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void PrintTiming(const std::string& name, double ms) {
+	std::cout << "  " << name << ": " << ms << " ms\n";
+}
+
+template <typename T>
+List<T> MakeRandomList(size_t amount, unsigned seed) {
+	List<T> list;
+	list.Capacity(amount);
+	std::mt19937 rng(seed);
+	for (size_t i = 0; i < amount; i++) {
+		list.Add(T(rng() % 1000));
+	}
+	return list;
+}
+
+
+void Benchmark_Removal() {
+	const size_t amount = 20000;
+	const size_t removals = 5000;
+
+	std::cout << "Removal (" << amount << " elements, " << removals << " RemoveAt from the front half):\n";
+
+	auto stable = MakeRandomList<int>(amount, 1);
+	PrintTiming("RemoveAt", TimeMs([&]() {
+		for (size_t i = 0; i < removals; i++) stable.RemoveAt(i % (stable.Count() / 2));
+	}));
+
+	auto unordered = MakeRandomList<int>(amount, 1);
+	PrintTiming("RemoveAtUnordered", TimeMs([&]() {
+		for (size_t i = 0; i < removals; i++) unordered.RemoveAtUnordered(i % (unordered.Count() / 2));
+	}));
+
+	std::cout << "RemoveIf (" << amount * 50 << " elements, ~50% removed):\n";
+
+	auto stableIf = MakeRandomList<int>(amount * 50, 2);
+	PrintTiming("RemoveIf", TimeMs([&]() { stableIf.RemoveIf([](int v) { return v < 500; }); }));
+
+	auto unorderedIf = MakeRandomList<int>(amount * 50, 2);
+	PrintTiming("RemoveIfUnordered", TimeMs([&]() { unorderedIf.RemoveIfUnordered([](int v) { return v < 500; }); }));
+
+	std::cout << "RemoveIf (" << amount * 50 << " elements, ~1% removed):\n";
+
+	auto stableFew = MakeRandomList<int>(amount * 50, 3);
+	PrintTiming("RemoveIf", TimeMs([&]() { stableFew.RemoveIf([](int v) { return v < 10; }); }));
+
+	auto unorderedFew = MakeRandomList<int>(amount * 50, 3);
+	PrintTiming("RemoveIfUnordered", TimeMs([&]() { unorderedFew.RemoveIfUnordered([](int v) { return v < 10; }); }));
+}
+
+
+void Benchmark_Copy() {
+	const size_t amount = 10000;
+	const size_t copies = 200;
+
+	std::cout << "Copy fan-out (" << amount << " strings, " << copies << " read-only copies):\n";
+
+	List<std::string> source;
+	for (size_t i = 0; i < amount; i++) {
+		source.Add("configuration entry number " + std::to_string(i));
+	}
+
+	size_t total = 0;
+	PrintTiming("List", TimeMs([&]() {
+		for (size_t i = 0; i < copies; i++) {
+			List<std::string> copy(source);
+			total += copy[i].size();
+		}
+	}));
+
+	CowList<std::string> cowSource(source);
+	PrintTiming("CowList", TimeMs([&]() {
+		for (size_t i = 0; i < copies; i++) {
+			const CowList<std::string> copy(cowSource);
+			total += copy[i].size();
+		}
+	}));
+
+	std::cout << "  (checksum " << total << ")\n";
+}
+
+
+void Benchmark_Reduce() {
+	const size_t amount = 4000000;
+
+	std::cout << "Reductions (" << amount << " floats):\n";
+
+	auto list = MakeRandomList<float>(amount, 4);
+
+	float loopSum = 0.0f, loopMax = list[0];
+	PrintTiming("hand loop Sum+Max", TimeMs([&]() {
+		for (auto e : list) {
+			loopSum += e;
+			loopMax = std::max(loopMax, e);
+		}
+	}));
+
+	float sum = 0.0f, max = 0.0f;
+	PrintTiming("Sum+Max", TimeMs([&]() {
+		sum = Sum(list);
+		max = Max(list);
+	}));
+
+	std::cout << "  (results " << loopSum << "/" << sum << ", " << loopMax << "/" << max << ")\n";
+}
+
+
+void Benchmark_RadixSort() {
+	const size_t amount = 2000000;
+
+	std::cout << "Sort (" << amount << " uint32_t):\n";
+
+	List<uint32_t> list;
+	list.Capacity(amount);
+	std::mt19937 rng(5);
+	for (size_t i = 0; i < amount; i++) {
+		list.Add(uint32_t(rng()));
+	}
+
+	List<uint32_t> copy(list);
+	PrintTiming("std::sort", TimeMs([&]() { std::sort(copy.begin(), copy.end()); }));
+
+	List<uint32_t> radix(list);
+	PrintTiming("List::Sort", TimeMs([&]() { radix.Sort(); }));
+
+	List<uint32_t> parallel(list);
+	PrintTiming("List::Sort (parallel)", TimeMs([&]() { parallel.Sort(LazyExecution::Parallel); }));
+}
+
+
+void Benchmark_ComparisonSort() {
+	const size_t amount = 500000;
+	const char* patterns[] = { "random", "sorted", "reversed", "few unique" };
+
+	std::cout << "Sort(compare) (" << amount << " int, std::greater / " << amount / 5 << " std::string):\n";
+
+	for (int pattern = 0; pattern < 4; pattern++) {
+		List<int> ints;
+		List<std::string> strings;
+		ints.Capacity(amount);
+		std::mt19937 rng(6);
+		for (size_t i = 0; i < amount; i++) {
+			int values[] = { int(rng()), -int(i), int(i), int(rng() % 16) };
+			ints.Add(values[pattern]);
+			if (i % 5 == 0) strings.Add("key_" + std::to_string(values[pattern]));
+		}
+		if (pattern == 1 || pattern == 2) std::sort(strings.begin(), strings.end(), [&](const std::string& a, const std::string& b) { return pattern == 1 ? a < b : a > b; });
+
+		std::cout << " " << patterns[pattern] << ":\n";
+
+		List<int> stdInts(ints);
+		PrintTiming("std::sort int", TimeMs([&]() { std::sort(stdInts.begin(), stdInts.end(), std::greater<>()); }));
+		List<int> listInts(ints);
+		PrintTiming("List::Sort int", TimeMs([&]() { listInts.Sort(std::greater<>()); }));
+		List<int> stableInts(ints);
+		PrintTiming("List::StableSort int", TimeMs([&]() { stableInts.StableSort(std::greater<>()); }));
+
+		List<std::string> stdStrings(strings);
+		PrintTiming("std::sort string", TimeMs([&]() { std::sort(stdStrings.begin(), stdStrings.end()); }));
+		List<std::string> listStrings(strings);
+		PrintTiming("List::Sort string", TimeMs([&]() { listStrings.Sort(); }));
+		List<std::string> stableStrings(strings);
+		PrintTiming("List::StableSort string", TimeMs([&]() { stableStrings.StableSort(); }));
+	}
+}
+
+
+void Benchmark_StringList() {
+	const size_t amount = 200000;
+
+	std::cout << "String workload (" << amount << " log lines: Add, append \"[processed]\" to half, RemoveIf unprocessed):\n";
+
+	PrintTiming("List<std::string>", TimeMs([&]() {
+		List<std::string> list;
+		for (size_t i = 0; i < amount; i++) {
+			list.Add("request " + std::to_string(i) + " served from cache node");
+		}
+		for (size_t i = 0; i < amount; i += 2) {
+			list[i] += "[processed]";
+		}
+		list.RemoveIf([](const std::string& v) { return v.find("[processed]") == std::string::npos; });
+	}));
+
+	PrintTiming("List<std::string> RemoveIfNotContains", TimeMs([&]() {
+		List<std::string> list;
+		for (size_t i = 0; i < amount; i++) {
+			list.Add("request " + std::to_string(i) + " served from cache node");
+		}
+		for (size_t i = 0; i < amount; i += 2) {
+			list[i] += "[processed]";
+		}
+		RemoveIfNotContains(list, "[processed]");
+	}));
+
+	PrintTiming("StringList", TimeMs([&]() {
+		StringList list;
+		for (size_t i = 0; i < amount; i++) {
+			list.Add("request " + std::to_string(i) + " served from cache node");
+		}
+		for (size_t i = 0; i < amount; i += 2) {
+			list.Append(i, "[processed]");
+		}
+		list.RemoveIf([](std::string_view v) { return v.find("[processed]") == std::string_view::npos; });
+	}));
+}
+
+
+void Benchmark_DictList() {
+	const size_t amount = 1000000;
+	const char* statuses[] = { "200 OK", "304 Not Modified", "404 Not Found", "500 Internal Server Error", "503 Service Unavailable Retry-After" };
+
+	std::cout << "Low-cardinality strings (" << amount << " elements, 5 distinct: Add, Find last, RemoveIf):\n";
+
+	PrintTiming("List<std::string>", TimeMs([&]() {
+		List<std::string> list;
+		for (size_t i = 0; i < amount; i++) list.Add(statuses[(i * 7) % 4]);
+		list.Add(statuses[4]);
+		volatile bool found = list.Find(std::string(statuses[4])) != nullptr;
+		(void)found;
+		list.RemoveIf([](const std::string& v) { return v[0] == '5'; });
+	}));
+
+	PrintTiming("DictList<std::string>", TimeMs([&]() {
+		DictList<std::string> list;
+		for (size_t i = 0; i < amount; i++) list.Add(statuses[(i * 7) % 4]);
+		list.Add(statuses[4]);
+		volatile size_t found = list.Find(statuses[4]);
+		(void)found;
+		list.RemoveIf([](const std::string& v) { return v[0] == '5'; });
+	}));
+}
+
+
+void Benchmark_PackedIntList() {
+	const size_t amount = 10000000;
+
+	List<uint32_t> raw;
+	PackedIntList<uint32_t> packed;
+	std::mt19937 gen(41);
+	uint32_t id = 0;
+	for (size_t i = 0; i < amount; i++) {
+		id += gen() % 64;
+		raw.Add(id);
+		packed.Add(id);
+	}
+
+	std::cout << "Sorted ids (" << amount << " uint32_t, deltas < 64): " << raw.Count() * sizeof(uint32_t) / (1 << 20) << " MB raw, "
+		<< packed.MemoryBytes() / (1 << 20) << " MB packed\n";
+
+	volatile uint64_t sink = 0;
+	PrintTiming("List scan", TimeMs([&]() {
+		uint64_t sum = 0;
+		for (uint32_t v : raw) sum += v;
+		sink = sum;
+	}));
+	PrintTiming("PackedIntList::ForEach", TimeMs([&]() {
+		uint64_t sum = 0;
+		packed.ForEach([&](uint32_t v) { sum += v; });
+		sink = sum;
+	}));
+	PrintTiming("PackedIntList::LowerBound x100000", TimeMs([&]() {
+		uint64_t sum = 0;
+		for (uint32_t i = 0; i < 100000; i++) sum += packed.LowerBound(i * 3001u);
+		sink = sum;
+	}));
+}
+
+
+void Benchmark_CompressedFloatList() {
+	const size_t amount = 1000000;
+	std::mt19937 gen(43);
+
+	//gauge: memory usage sampled every 10s, changes every few samples; counter: requests served, integral and increasing
+	List<double> gauge;
+	List<double> counter;
+	double memory = 512.0;
+	double requests = 0;
+	for (size_t i = 0; i < amount; i++) {
+		if (gen() % 4 == 0) memory = std::max(0.0, memory + double(int(gen() % 33) - 16) * 0.25);
+		requests += double(gen() % 100);
+		gauge.Add(memory);
+		counter.Add(requests);
+	}
+
+	CompressedTimestampList timestamps;
+	int64_t t = 1700000000000;
+	for (size_t i = 0; i < amount; i++) {
+		t += gen() % 20 == 0 ? 10000 + int64_t(gen() % 200) - 100 : 10000;
+		timestamps.Add(t);
+	}
+	std::cout << "Metric window (" << amount << " samples): timestamps " << amount * sizeof(int64_t) / 1024 << " KB raw, " << timestamps.MemoryBytes() / 1024 << " KB delta-of-delta\n";
+
+	for (auto series : { std::make_pair("gauge", &gauge), std::make_pair("counter", &counter) }) {
+		CompressedFloatList compressed;
+		const double encodeMs = TimeMs([&]() {
+			for (double v : *series.second) compressed.Add(v);
+		});
+		std::cout << "  " << series.first << ": " << series.second->Count() * sizeof(double) / 1024 << " KB raw, " << compressed.MemoryBytes() / 1024 << " KB compressed\n";
+
+		volatile double sink = 0;
+		PrintTiming(std::string(series.first) + " Add", encodeMs);
+		PrintTiming(std::string(series.first) + " List scan", TimeMs([&]() {
+			double sum = 0;
+			for (double v : *series.second) sum += v;
+			sink = sum;
+		}));
+		PrintTiming(std::string(series.first) + " CompressedFloatList scan", TimeMs([&]() {
+			double sum = 0;
+			for (double v : compressed) sum += v;
+			sink = sum;
+		}));
+		PrintTiming(std::string(series.first) + " CompressedFloatList::Get x10000", TimeMs([&]() {
+			double sum = 0;
+			for (size_t i = 0; i < 10000; i++) sum += compressed[(i * 7919) % amount];
+			sink = sum;
+		}));
+	}
+}
+
+
+void Benchmark_Prefetch() {
+	const size_t amount = 2000000;
+
+	//payloads allocated up front and handed out in shuffled order, so consecutive elements point all over the heap
+	struct Payload {
+		uint64_t id;
+		char padding[56];
+	};
+	List<Payload> storage;
+	storage.Capacity(amount);
+	for (size_t i = 0; i < amount; i++) storage.Add(Payload{ i, {} });
+
+	List<Payload*> pointers;
+	for (auto& payload : storage) pointers.Add(&payload);
+	std::shuffle(pointers.begin(), pointers.end(), std::mt19937(48));
+
+	std::cout << "Pointer-chasing FindIf (" << amount << " shuffled Payload*, no match):\n";
+
+	//a bare load is already overlapped by out-of-order execution, prefetching pays off once the predicate does some work
+	auto compare = [&](const Payload* p) { return p->id == amount; };
+	auto hashed = [&](const Payload* p) {
+		uint64_t h = p->id;
+		for (int k = 0; k < 16; k++) h = h * 0x9E3779B97F4A7C15ull + uint64_t(k);
+		return h == amount;
+	};
+
+	volatile bool sink = false;
+	PrintTiming("List::FindIf compare", TimeMs([&]() { sink = pointers.FindIf(compare) != nullptr; }));
+	PrintTiming("FindIfPrefetch compare", TimeMs([&]() { sink = FindIfPrefetch(pointers, compare) != nullptr; }));
+	PrintTiming("List::FindIf hash", TimeMs([&]() { sink = pointers.FindIf(hashed) != nullptr; }));
+	PrintTiming("FindIfPrefetch hash", TimeMs([&]() { sink = FindIfPrefetch(pointers, hashed) != nullptr; }));
+}
+
+
+void Main_Benchmark_List() {
+	std::cout << "\n\nBenchmarks\n";
+	Benchmark_Removal();
+	Benchmark_Copy();
+	Benchmark_Reduce();
+	Benchmark_RadixSort();
+	Benchmark_ComparisonSort();
+	Benchmark_StringList();
+	Benchmark_DictList();
+	Benchmark_PackedIntList();
+	Benchmark_CompressedFloatList();
+	Benchmark_Prefetch();
+}
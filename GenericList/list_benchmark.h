@@ -0,0 +1,2 @@
+#pragma once
+void Main_Benchmark_List();
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "list.h"
+#include "list_view.h"
+#include "list_generator.h"
+
+//Bounded queue of List<T> batches between one producer and one consumer. Push blocks while capacity batches are
+//waiting (backpressure), Pop blocks until a batch arrives, and both stop once the channel is closed.
+//With C++20 coroutines the consumer can co_await Next(batch) instead - it is resumed on the producer's thread.
+template <typename T>
+class ListChannel {
+public:
+    explicit ListChannel(size_t capacity) : capacity(capacity), closed(false) {}
+
+    ListChannel(const ListChannel&) = delete;
+    ListChannel& operator=(const ListChannel&) = delete;
+
+    //false (batch dropped) if the channel was closed
+    bool Push(List<T>&& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return queue.Count() < capacity || closed; });
+        if (closed) return false;
+        queue.Add(std::move(batch));
+        changed.notify_all();
+        ResumeWaiter(lock);
+        return true;
+    }
+
+    //Never blocks: false (batch left untouched) if capacity batches are waiting or the channel was closed
+    bool TryPush(List<T>&& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (queue.Count() >= capacity || closed) return false;
+        queue.Add(std::move(batch));
+        changed.notify_all();
+        ResumeWaiter(lock);
+        return true;
+    }
+
+    //false once the channel is closed and drained
+    bool Pop(List<T>& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return queue.Count() != 0 || closed; });
+        return TakeFront(batch);
+    }
+
+    //Batches already pushed can still be popped
+    void Close() {
+        std::unique_lock<std::mutex> lock(mutex);
+        closed = true;
+        changed.notify_all();
+        ResumeWaiter(lock);
+    }
+
+#if LIST_HAS_COROUTINES
+    //co_await channel.Next(batch) - true with the next batch, false once the channel is closed and drained
+    class NextAwaiter {
+    public:
+        NextAwaiter(ListChannel& channel, List<T>& batch) : channel(channel), batch(batch) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(channel.mutex);
+            if (channel.queue.Count() != 0 || channel.closed) return false;
+            channel.waiter = handle;
+            return true;
+        }
+        bool await_resume() {
+            std::lock_guard<std::mutex> lock(channel.mutex);
+            return channel.TakeFront(batch);
+        }
+
+    private:
+        ListChannel& channel;
+        List<T>& batch;
+    };
+
+    NextAwaiter Next(List<T>& batch) { return NextAwaiter(*this, batch); }
+#endif
+
+private:
+    List<List<T>> queue;
+    size_t capacity;
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable changed;
+#if LIST_HAS_COROUTINES
+    std::coroutine_handle<> waiter;
+#endif
+
+    //lock held
+    bool TakeFront(List<T>& batch) {
+        if (queue.Count() == 0) return false;
+        batch = std::move(queue[0]);
+        queue.RemoveAt(0);
+        changed.notify_all();
+        return true;
+    }
+
+    //A suspended coroutine consumer continues on this thread, outside the lock
+    void ResumeWaiter(std::unique_lock<std::mutex>& lock) {
+#if LIST_HAS_COROUTINES
+        auto handle = std::exchange(waiter, nullptr);
+        lock.unlock();
+        if (handle) handle.resume();
+#else
+        (void)lock;
+#endif
+    }
+};
+
+//Streams elements to a consumer in batches of batchSize while they are still being produced: Add moves elements into
+//the current batch and hands it to the channel once full (blocking while maxBatches are unconsumed), Close flushes
+//the last partial batch. The consumer reads batches with Next (blocking) or co_await NextAsync (C++20).
+//Destroying a producer that wasn't closed never waits for the consumer: the partial batch is dropped if the channel is full.
+template <typename T>
+class ListProducer {
+public:
+    ListProducer(size_t batchSize, size_t maxBatches = 4) : batchSize(batchSize), channel(maxBatches) {
+        batch.Capacity(batchSize);
+    }
+
+    ~ListProducer() {
+        if (batch.Count() != 0) channel.TryPush(std::move(batch));
+        channel.Close();
+    }
+
+    //Producer side
+    void Add(T value) {
+        batch.Add(std::move(value));
+        if (batch.Count() >= batchSize) Flush();
+    }
+
+    void AddRange(ListView<T> values) {
+        for (const auto& e : values) Add(e);
+    }
+
+    void Close() {
+        if (batch.Count() != 0) Flush();
+        channel.Close();
+    }
+
+    //Consumer side
+    bool Next(List<T>& out) { return channel.Pop(out); }
+#if LIST_HAS_COROUTINES
+    typename ListChannel<T>::NextAwaiter NextAsync(List<T>& out) { return channel.Next(out); }
+#endif
+
+private:
+    size_t batchSize;
+    List<T> batch;
+    ListChannel<T> channel;
+
+    void Flush() {
+        channel.Push(std::move(batch));
+        batch = List<T>();
+        batch.Capacity(batchSize);
+    }
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+//C++20 coroutine support - everything below needs /std:c++20 (or -std=c++20), the rest of the library stays C++17
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define LIST_HAS_COROUTINES 1
+#endif
+#endif
+#ifndef LIST_HAS_COROUTINES
+#define LIST_HAS_COROUTINES 0
+#endif
+
+#if LIST_HAS_COROUTINES
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+#include "list_view.h"
+
+//Lazily yields references (Generator<T&>) or values from a coroutine, one element per resume - nothing is materialized.
+//Single pass: begin() starts the coroutine, iterators only compare against end().
+template <typename Ref>
+class Generator {
+    using Value = std::remove_reference_t<Ref>;
+
+public:
+    struct promise_type {
+        Value* current = nullptr;
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        //the yielded object outlives the suspension (it is part of the co_yield expression), so a pointer is enough
+        std::suspend_always yield_value(Value& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        std::suspend_always yield_value(Value&& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    struct Sentinel {};
+
+    class Iterator {
+    public:
+        explicit Iterator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        Ref operator*() const { return static_cast<Ref>(*handle.promise().current); }
+        Iterator& operator++() {
+            Resume(handle);
+            return *this;
+        }
+        bool operator==(Sentinel) const { return handle.done(); }
+        bool operator!=(Sentinel) const { return !handle.done(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Generator(const Generator&) = delete;
+    Generator& operator=(Generator other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~Generator() {
+        if (handle) handle.destroy();
+    }
+
+    Iterator begin() {
+        Resume(handle);
+        return Iterator(handle);
+    }
+    Sentinel end() const { return Sentinel(); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    static void Resume(std::coroutine_handle<promise_type> handle) {
+        handle.resume();
+        if (handle.promise().error) std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+    }
+};
+
+//Yields the elements of a span/view (T& for ListSpan<T>, const T& for ListView<T>)
+template <typename T>
+Generator<T&> Generate(ListSpan<T> span) {
+    for (auto& e : span) co_yield e;
+}
+
+template <typename T, typename Allocator>
+Generator<T&> Generate(List<T, Allocator>& list) {
+    return Generate(ListSpan<T>(list));
+}
+template <typename T, typename Allocator>
+Generator<const T&> Generate(const List<T, Allocator>& list) {
+    return Generate(ListView<T>(list));
+}
+#endif
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "list.h"
+#include "list_pipeline.h"
+#include "list_channel.h"
+
+//Asynchronous bulk LoadAsync/SaveAsync of Lists to binary snapshot files. Completion is signalled through a std::future,
+//an onDone callback overload, or (C++20) co_await SaveAwait/LoadAwait.
+//Trivially copyable elements are stored raw and split into large chunks read/written in parallel, each worker with its
+//own stream positioned at its chunk (positional I/O, no shared file offset). Other element types go through
+//ListCodec<T> (std::string is provided): one thread does the I/O a chunk at a time while the task encodes/decodes the
+//neighbouring chunk, so I/O overlaps with (de)serialization.
+//SaveAsync reads the List until completion - it must stay alive and unmodified until then.
+//File: 8 byte magic, element size (0 for ListCodec elements), element count, then the payload.
+namespace list_io {
+    struct IoOptions {
+        size_t chunkBytes = size_t(8) << 20;
+        size_t threads = 0; //0 = one per hardware thread
+    };
+
+    constexpr char magic[8] = { 'G', 'L', 'I', 'S', 'T', '\0', '\0', '\1' };
+
+    struct Header {
+        char magic[8];
+        uint64_t elementSize;
+        uint64_t count;
+    };
+
+    inline size_t ThreadCount(const IoOptions& options, size_t chunks) {
+        const size_t threads = options.threads != 0 ? options.threads : std::max(std::thread::hardware_concurrency(), 1u);
+        return std::max(std::min(threads, chunks), size_t(1));
+    }
+
+    inline void CheckOptions(const IoOptions& options) {
+        if (options.chunkBytes == 0) throw std::invalid_argument("IoOptions::chunkBytes must not be 0");
+    }
+
+    //Bytes left from the current read position to the end of the file (the position is kept)
+    inline uint64_t RemainingBytes(std::ifstream& file) {
+        const auto position = file.tellg();
+        file.seekg(0, std::ios::end);
+        const auto end = file.tellg();
+        file.seekg(position);
+        return uint64_t(end - position);
+    }
+
+    inline void CheckStream(const std::ios& stream, const std::string& action, const std::string& path) {
+        if (!stream) throw std::runtime_error(std::string("Cannot ") + action + std::string(" file: ") + path);
+    }
+}
+
+//Serialization of non trivially copyable elements - specialize for other types.
+//Encode appends value's bytes to out, Decode reads one value from [first, last) and advances first,
+//returning false (without advancing) if the bytes end mid-value.
+template <typename T>
+struct ListCodec;
+
+template <typename Char, typename Traits, typename Alloc>
+struct ListCodec<std::basic_string<Char, Traits, Alloc>> {
+    using String = std::basic_string<Char, Traits, Alloc>;
+
+    static void Encode(const String& value, List<char>& out) {
+        const uint64_t length = value.size();
+        out.AddRange(reinterpret_cast<const char*>(&length), reinterpret_cast<const char*>(&length) + sizeof(length));
+        out.AddRange(reinterpret_cast<const char*>(value.data()), reinterpret_cast<const char*>(value.data() + value.size()));
+    }
+
+    static bool Decode(const char*& first, const char* last, String& value) {
+        uint64_t length;
+        if (size_t(last - first) < sizeof(length)) return false;
+        std::memcpy(&length, first, sizeof(length));
+        if (uint64_t(last - first - sizeof(length)) < length * sizeof(Char)) return false;
+
+        value.resize(size_t(length));
+        std::memcpy(&value[0], first + sizeof(length), size_t(length) * sizeof(Char));
+        first += sizeof(length) + size_t(length) * sizeof(Char);
+        return true;
+    }
+};
+
+
+namespace list_io {
+    //Synchronous Save/Load behind the async entry points - they run on the calling thread
+    template <typename T, typename Allocator>
+    void Save(const List<T, Allocator>& list, const std::string& path, const IoOptions& options) {
+        CheckOptions(options);
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(header.magic));
+        header.count = list.Count();
+
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            header.elementSize = sizeof(T);
+            const size_t bytes = list.Count() * sizeof(T);
+            {
+                //header, and the file extended to its final size so every chunk can be written in place
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                CheckStream(file, "create", path);
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                if (bytes != 0) {
+                    file.seekp(std::streamoff(sizeof(header) + bytes - 1));
+                    file.put('\0');
+                }
+                CheckStream(file, "write", path);
+            }
+
+            const size_t chunks = (bytes + options.chunkBytes - 1) / options.chunkBytes;
+            const char* data = reinterpret_cast<const char*>(list.begin());
+            lazy_detail::ForEachChunk(chunks, ThreadCount(options, chunks), [&](size_t chunk) {
+                const size_t offset = chunk * options.chunkBytes;
+                std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+                file.seekp(std::streamoff(sizeof(header) + offset));
+                file.write(data + offset, std::streamsize(std::min(options.chunkBytes, bytes - offset)));
+                CheckStream(file, "write", path);
+            });
+        }
+        else {
+            header.elementSize = 0;
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            CheckStream(file, "create", path);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            //this thread encodes the next chunk while the writer thread writes the previous one
+            //one exception_ptr per thread, checked after the join
+            ListChannel<char> queue(2);
+            std::exception_ptr error;
+            std::exception_ptr writeError;
+            std::thread writer([&]() {
+                List<char> chunk;
+                while (queue.Pop(chunk)) {
+                    file.write(chunk.begin(), std::streamsize(chunk.Count()));
+                    if (!file) {
+                        writeError = std::make_exception_ptr(std::runtime_error(std::string("Cannot write file: ") + path));
+                        queue.Close();
+                    }
+                }
+            });
+
+            try {
+                List<char> chunk;
+                for (const auto& e : list) {
+                    ListCodec<T>::Encode(e, chunk);
+                    if (chunk.Count() >= options.chunkBytes) {
+                        queue.Push(std::move(chunk));
+                        chunk = List<char>();
+                    }
+                }
+                if (chunk.Count() != 0) queue.Push(std::move(chunk));
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            queue.Close();
+            writer.join();
+            if (writeError) std::rethrow_exception(writeError);
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    template <typename T>
+    List<T> Load(const std::string& path, const IoOptions& options) {
+        CheckOptions(options);
+        Header header;
+        std::ifstream file(path, std::ios::binary);
+        CheckStream(file, "open", path);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        CheckStream(file, "read", path);
+        if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0) throw std::runtime_error(std::string("Not a List snapshot: ") + path);
+        const uint64_t payloadBytes = RemainingBytes(file);
+
+        List<T> list;
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (header.elementSize != sizeof(T)) throw std::invalid_argument(std::string("Snapshot element size doesn't match the List: ") + path);
+            if (header.count > payloadBytes / sizeof(T)) throw std::runtime_error(std::string("Truncated List snapshot: ") + path);
+            file.close();
+
+            //every element is overwritten by the chunk reads
+            const size_t bytes = size_t(header.count) * sizeof(T);
+            const size_t chunks = (bytes + options.chunkBytes - 1) / options.chunkBytes;
+            char* data = reinterpret_cast<char*>(list.AddUninitialized(size_t(header.count)));
+            lazy_detail::ForEachChunk(chunks, ThreadCount(options, chunks), [&](size_t chunk) {
+                const size_t offset = chunk * options.chunkBytes;
+                std::ifstream part(path, std::ios::binary);
+                part.seekg(std::streamoff(sizeof(header) + offset));
+                part.read(data + offset, std::streamsize(std::min(options.chunkBytes, bytes - offset)));
+                CheckStream(part, "read", path);
+            });
+        }
+        else {
+            if (header.elementSize != 0) throw std::invalid_argument(std::string("Snapshot element size doesn't match the List: ") + path);
+            //the count isn't trusted for the reservation: a value can't take less than a byte with the provided codecs
+            list.Capacity(size_t(std::min(header.count, payloadBytes)));
+
+            //the reader thread reads ahead while this thread decodes - values may straddle chunks, leftovers carry over
+            ListChannel<char> queue(2);
+            std::thread reader([&]() {
+                std::unique_ptr<char[]> buffer(new char[options.chunkBytes]);
+                while (file) {
+                    file.read(buffer.get(), std::streamsize(options.chunkBytes));
+                    if (file.gcount() == 0) break;
+
+                    List<char> chunk;
+                    chunk.AddRange(buffer.get(), buffer.get() + file.gcount());
+                    queue.Push(std::move(chunk));
+                }
+                queue.Close();
+            });
+
+            std::exception_ptr error;
+            try {
+                List<char> pending;
+                List<char> chunk;
+                T value;
+                while (queue.Pop(chunk)) {
+                    pending.AddRange(chunk.begin(), chunk.end());
+                    const char* first = pending.begin();
+                    while (list.Count() < header.count && ListCodec<T>::Decode(first, pending.end(), value)) list.Add(std::move(value));
+                    pending.RemoveRange(0, size_t(first - pending.begin()));
+                }
+            }
+            catch (...) {
+                error = std::current_exception();
+                queue.Close();
+            }
+            reader.join();
+            if (error) std::rethrow_exception(error);
+            if (list.Count() != header.count) throw std::runtime_error(std::string("Truncated List snapshot: ") + path);
+        }
+        return list;
+    }
+
+    template <typename Callback, typename... Args>
+    using IfCallback = std::enable_if_t<std::is_invocable_v<Callback&, std::exception_ptr, Args...>, int>;
+}
+
+
+template <typename T, typename Allocator>
+std::future<void> SaveAsync(const List<T, Allocator>& list, std::string path, list_io::IoOptions options = list_io::IoOptions()) {
+    return std::async(std::launch::async, [&list, path, options]() { list_io::Save(list, path, options); });
+}
+
+//Callback completion: onDone(error) is called on the I/O thread once the file is written (error is null on success)
+template <typename T, typename Allocator, typename Callback, list_io::IfCallback<Callback> = 0>
+void SaveAsync(const List<T, Allocator>& list, std::string path, Callback onDone, list_io::IoOptions options = list_io::IoOptions()) {
+    std::thread([&list, path, onDone, options]() mutable {
+        std::exception_ptr error;
+        try {
+            list_io::Save(list, path, options);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        onDone(error);
+    }).detach();
+}
+
+template <typename T>
+std::future<List<T>> LoadAsync(std::string path, list_io::IoOptions options = list_io::IoOptions()) {
+    return std::async(std::launch::async, [path, options]() { return list_io::Load<T>(path, options); });
+}
+
+//Callback completion: onDone(error, list) is called on the I/O thread (list is empty if error isn't null)
+template <typename T, typename Callback, list_io::IfCallback<Callback, List<T>> = 0>
+void LoadAsync(std::string path, Callback onDone, list_io::IoOptions options = list_io::IoOptions()) {
+    std::thread([path, onDone, options]() mutable {
+        std::exception_ptr error;
+        List<T> list;
+        try {
+            list = list_io::Load<T>(path, options);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        onDone(error, std::move(list));
+    }).detach();
+}
+
+#if LIST_HAS_COROUTINES
+namespace list_io {
+    //co_await SaveAwait(list, path) / co_await LoadAwait<T>(path): the coroutine is resumed on the I/O thread,
+    //and the I/O exception (if any) is rethrown from the co_await
+    template <typename T, typename Allocator>
+    class SaveAwaiter {
+    public:
+        SaveAwaiter(const List<T, Allocator>& list, std::string path, IoOptions options) : list(list), path(std::move(path)), options(options) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            //may resume before this returns - nothing is touched after the call
+            SaveAsync(list, path, [this, handle](std::exception_ptr e) { error = e; handle.resume(); }, options);
+        }
+        void await_resume() {
+            if (error) std::rethrow_exception(error);
+        }
+
+    private:
+        const List<T, Allocator>& list;
+        std::string path;
+        IoOptions options;
+        std::exception_ptr error;
+    };
+
+    template <typename T>
+    class LoadAwaiter {
+    public:
+        LoadAwaiter(std::string path, IoOptions options) : path(std::move(path)), options(options) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            LoadAsync<T>(path, [this, handle](std::exception_ptr e, List<T> loaded) {
+                error = e;
+                list = std::move(loaded);
+                handle.resume();
+            }, options);
+        }
+        List<T> await_resume() {
+            if (error) std::rethrow_exception(error);
+            return std::move(list);
+        }
+
+    private:
+        std::string path;
+        IoOptions options;
+        std::exception_ptr error;
+        List<T> list;
+    };
+}
+
+template <typename T, typename Allocator>
+list_io::SaveAwaiter<T, Allocator> SaveAwait(const List<T, Allocator>& list, std::string path, list_io::IoOptions options = list_io::IoOptions()) {
+    return list_io::SaveAwaiter<T, Allocator>(list, std::move(path), options);
+}
+
+template <typename T>
+list_io::LoadAwaiter<T> LoadAwait(std::string path, list_io::IoOptions options = list_io::IoOptions()) {
+    return list_io::LoadAwaiter<T>(std::move(path), options);
+}
+#endif
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+
+//Lazy, fused pipelines over contiguous elements: list.Lazy().Filter(p).Map(f).Take(n).Collect()
+//Stages only describe the work - nothing runs until a terminal operation (Collect, Reduce, Count, ForEach) is called,
+//and then every stage is applied to one element at a time in a single sweep of the buffer, without intermediate Lists.
+//Each stage wraps the previous one: stage(element, emit) pushes zero or more values to emit,
+//and returns false once no more elements are needed (lets Take stop the sweep early).
+
+namespace lazy_detail {
+    //Minimum elements per chunk before a parallel execution is worth the thread start-up cost
+    constexpr size_t minParallelChunk = 1 << 14;
+
+    constexpr size_t unknownCount = size_t(-1);
+
+    struct IdentityStage {
+        template <typename In>
+        using Out = const In&;
+
+        static constexpr bool ordered = false; //true if the result depends on which elements came before (Take)
+
+        //Amount of values produced from n elements, if known without running the pipeline
+        size_t ExactCount(size_t n) const { return n; }
+
+        template <typename E, typename Emit>
+        bool operator()(const E& e, Emit&& emit) { return emit(e); }
+    };
+
+    template <typename Prev, typename Predicate>
+    struct FilterStage {
+        Prev prev;
+        Predicate pred;
+
+        template <typename In>
+        using Out = typename Prev::template Out<In>;
+
+        static constexpr bool ordered = Prev::ordered;
+
+        size_t ExactCount(size_t) const { return unknownCount; }
+
+        template <typename E, typename Emit>
+        bool operator()(const E& e, Emit&& emit) {
+            return prev(e, [&](auto&& v) { return pred(v) ? emit(std::forward<decltype(v)>(v)) : true; });
+        }
+    };
+
+    template <typename Prev, typename Func>
+    struct MapStage {
+        Prev prev;
+        Func func;
+
+        template <typename In>
+        using Out = std::invoke_result_t<Func&, typename Prev::template Out<In>>;
+
+        static constexpr bool ordered = Prev::ordered;
+
+        size_t ExactCount(size_t n) const { return prev.ExactCount(n); }
+
+        template <typename E, typename Emit>
+        bool operator()(const E& e, Emit&& emit) {
+            return prev(e, [&](auto&& v) { return emit(func(std::forward<decltype(v)>(v))); });
+        }
+    };
+
+    template <typename Prev>
+    struct TakeStage {
+        Prev prev;
+        size_t remaining; //stages are copied before each run, so this is per-run state
+
+        template <typename In>
+        using Out = typename Prev::template Out<In>;
+
+        static constexpr bool ordered = true;
+
+        size_t ExactCount(size_t n) const {
+            const size_t prevCount = prev.ExactCount(n);
+            return prevCount == unknownCount ? unknownCount : std::min(prevCount, remaining);
+        }
+
+        template <typename E, typename Emit>
+        bool operator()(const E& e, Emit&& emit) {
+            if (remaining == 0) return false;
+            return prev(e, [&](auto&& v) {
+                if (remaining == 0) return false;
+                --remaining;
+                return emit(std::forward<decltype(v)>(v)) && remaining > 0;
+            });
+        }
+    };
+
+    //Amount of chunks to split n elements into for the given execution (1 = run on the calling thread)
+    inline size_t ChunkCount(LazyExecution execution, size_t n) {
+        if (execution == LazyExecution::Sequential) return 1;
+
+        const size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+        return std::max(std::min(threads, n / minParallelChunk), size_t(1));
+    }
+
+    //Runs func(chunk) for every chunk in [0, chunks) on up to threads threads, the calling thread included.
+    //Every thread is joined before returning, then the first exception thrown by func is rethrown (the remaining chunks are skipped).
+    template <typename Func>
+    void ForEachChunk(size_t chunks, size_t threads, Func&& func) {
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto worker = [&]() {
+            for (size_t chunk = next++; chunk < chunks; chunk = next++) {
+                try {
+                    func(chunk);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                    next = chunks;
+                }
+            }
+        };
+
+        List<std::thread> workers;
+        workers.Capacity(threads - 1);
+        try {
+            for (size_t i = 1; i < threads; i++) workers.Add(worker);
+        }
+        catch (...) { //thread creation failed - stop the started ones before leaving
+            next = chunks;
+            for (auto& thread : workers) thread.join();
+            throw;
+        }
+        worker();
+        for (auto& thread : workers) thread.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+    //Calls func(chunkFirst, chunkLast) for each chunk of [first, last) on its own thread, and appends the returned values in chunk order.
+    //Results don't need to be default constructible. Exceptions from func are rethrown once every thread is done.
+    template <typename T, typename Result, typename Func>
+    void RunChunks(const T* first, const T* last, size_t chunks, List<Result>& results, Func&& func) {
+        const size_t n = size_t(last - first);
+        const size_t chunkSize = (n + chunks - 1) / chunks;
+        List<std::optional<Result>> slots;
+        slots.Capacity(chunks);
+        for (size_t i = 0; i < chunks; i++) {
+            slots.Add();
+        }
+
+        ForEachChunk(chunks, chunks, [&](size_t i) {
+            slots[i].emplace(func(first + std::min(i * chunkSize, n), first + std::min((i + 1) * chunkSize, n)));
+        });
+
+        results.Capacity(results.Count() + chunks);
+        for (auto& slot : slots) {
+            results.Add(std::move(*slot));
+        }
+    }
+}
+
+
+template <typename T, typename Stage = lazy_detail::IdentityStage>
+class LazyList {
+public:
+    //Type of the values reaching the end of the pipeline
+    using value_type = std::decay_t<typename Stage::template Out<T>>;
+
+    LazyList(const T* first, const T* last) : first(first), last(last), stage() {
+
+    }
+
+    LazyList(const T* first, const T* last, Stage stage) : first(first), last(last), stage(std::move(stage)) {
+
+    }
+
+
+    //Keeps the values for which pred returns true
+    template <typename Predicate>
+    auto Filter(Predicate&& pred) const {
+        using Next = lazy_detail::FilterStage<Stage, std::decay_t<Predicate>>;
+        return LazyList<T, Next>(first, last, Next{ stage, std::forward<Predicate>(pred) });
+    }
+
+    //Replaces each value by func(value)
+    template <typename Func>
+    auto Map(Func&& func) const {
+        using Next = lazy_detail::MapStage<Stage, std::decay_t<Func>>;
+        return LazyList<T, Next>(first, last, Next{ stage, std::forward<Func>(func) });
+    }
+
+    //Keeps the first n values, and stops reading elements once they are found
+    auto Take(size_t n) const {
+        using Next = lazy_detail::TakeStage<Stage>;
+        return LazyList<T, Next>(first, last, Next{ stage, n });
+    }
+
+
+    //Runs the pipeline into a new List (pre-sized when the result count is known up front)
+    template <typename Allocator = std::allocator<value_type>>
+    List<value_type, Allocator> Collect(LazyExecution execution = LazyExecution::Sequential) const {
+        const size_t chunks = ChunkCount(execution);
+        if (chunks <= 1) return CollectRange<Allocator>(first, last);
+
+        List<List<value_type, Allocator>> results;
+        RunChunks(chunks, results, [&](const T* chunkFirst, const T* chunkLast) { return CollectRange<Allocator>(chunkFirst, chunkLast); });
+
+        size_t total = 0;
+        for (const auto& result : results) total += result.Count();
+
+        List<value_type, Allocator> collected;
+        collected.Capacity(total);
+        for (auto& result : results) {
+            for (auto& value : result) {
+                collected.Add(std::move(value));
+            }
+        }
+        return collected;
+    }
+
+    //Folds the values into init with op(accumulator, value).
+    //Parallel execution starts every chunk from init and then folds the chunk results together with op(accumulator, accumulator),
+    //so op must be associative and init must be its identity (eg: 0 for +).
+    template <typename Acc, typename Op>
+    Acc Reduce(Acc init, Op&& op, LazyExecution execution = LazyExecution::Sequential) const {
+        const size_t chunks = ChunkCount(execution);
+        if (chunks <= 1) return ReduceRange(first, last, std::move(init), op);
+
+        List<Acc> results;
+        RunChunks(chunks, results, [&](const T* chunkFirst, const T* chunkLast) { return ReduceRange(chunkFirst, chunkLast, init, op); });
+
+        for (auto& result : results) {
+            init = op(std::move(init), std::move(result));
+        }
+        return init;
+    }
+
+    //Amount of values reaching the end of the pipeline
+    size_t Count(LazyExecution execution = LazyExecution::Sequential) const {
+        const size_t exact = stage.ExactCount(size_t(last - first));
+        if (exact != lazy_detail::unknownCount) return exact;
+
+        return Map([](const auto&) { return size_t(1); }).Reduce(size_t(0), [](size_t a, size_t b) { return a + b; }, execution);
+    }
+
+    //Calls func on each value, in order
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        Stage run = stage;
+        for (auto ptr = first; ptr < last; ++ptr) {
+            if (!run(*ptr, [&](auto&& v) { func(std::forward<decltype(v)>(v)); return true; })) break;
+        }
+    }
+
+
+
+private:
+    const T* first;
+    const T* last;
+    Stage stage;
+
+    size_t ChunkCount(LazyExecution execution) const {
+        if (Stage::ordered) return 1; //Take needs to see elements in order
+        return lazy_detail::ChunkCount(execution, size_t(last - first));
+    }
+
+    template <typename Result, typename Func>
+    void RunChunks(size_t chunks, List<Result>& results, Func&& func) const {
+        lazy_detail::RunChunks(first, last, chunks, results, std::forward<Func>(func));
+    }
+
+    template <typename Allocator>
+    List<value_type, Allocator> CollectRange(const T* rangeFirst, const T* rangeLast) const {
+        List<value_type, Allocator> collected;
+        const size_t exact = stage.ExactCount(size_t(rangeLast - rangeFirst));
+        if (exact != lazy_detail::unknownCount) collected.Capacity(exact);
+
+        Stage run = stage;
+        for (auto ptr = rangeFirst; ptr < rangeLast; ++ptr) {
+            if (!run(*ptr, [&](auto&& v) { collected.Add(std::forward<decltype(v)>(v)); return true; })) break;
+        }
+        return collected;
+    }
+
+    template <typename Acc, typename Op>
+    Acc ReduceRange(const T* rangeFirst, const T* rangeLast, Acc acc, Op& op) const {
+        Stage run = stage;
+        for (auto ptr = rangeFirst; ptr < rangeLast; ++ptr) {
+            if (!run(*ptr, [&](auto&& v) { acc = op(std::move(acc), std::forward<decltype(v)>(v)); return true; })) break;
+        }
+        return acc;
+    }
+};
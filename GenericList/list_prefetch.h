@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#include "list.h"
+#include "list_view.h"
+
+//Prefetching scans for Lists of pointer-like elements (T*, unique_ptr, shared_ptr, long strings), where each predicate call
+//stalls on a cache miss behind the element: while element i is tested, the memory element i + distance points to is
+//already being fetched. address(element) returns that memory (nullptr to skip), AutoPrefetch handles the common cases.
+//Only worth it when the pointed-to data is scattered and the list is larger than the cache - measure first.
+namespace prefetch_detail {
+    constexpr size_t defaultDistance = 16;
+
+    inline void Prefetch(const void* address) {
+#if defined(_MSC_VER) && !defined(__clang__)
+#if defined(_M_X64) || defined(_M_IX86)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+#else
+        __builtin_prefetch(address);
+#endif
+    }
+
+    //Wraps pred so every call first prefetches the target of the element distance places ahead -
+    //relies on FindIf/RemoveIf testing the elements in place, in order
+    template <typename T, typename Predicate, typename Address>
+    auto Prefetching(const T* last, Predicate& pred, Address& address, size_t distance) {
+        return [last, &pred, &address, distance](const T& e) {
+            if (size_t(last - &e) > distance) {
+                const void* target = address(*(&e + distance));
+                if (target != nullptr) Prefetch(target);
+            }
+            return bool(pred(e));
+        };
+    }
+
+    //Warms up the targets of the first distance elements, which no earlier call prefetched
+    template <typename T, typename Address>
+    void PrefetchFirst(const T* first, const T* last, Address& address, size_t distance) {
+        for (auto ptr = first; ptr < last && size_t(ptr - first) < distance; ++ptr) {
+            const void* target = address(*ptr);
+            if (target != nullptr) Prefetch(target);
+        }
+    }
+}
+
+//Memory behind pointer-like elements: raw and smart pointers, and the character buffer of strings
+struct AutoPrefetch {
+    //anything else isn't prefetched
+    template <typename T>
+    const void* operator()(const T&) const { return nullptr; }
+    template <typename T>
+    const void* operator()(T* const& e) const { return e; }
+    template <typename T, typename Deleter>
+    const void* operator()(const std::unique_ptr<T, Deleter>& e) const { return e.get(); }
+    template <typename T>
+    const void* operator()(const std::shared_ptr<T>& e) const { return e.get(); }
+    template <typename Char, typename Traits, typename Alloc>
+    const void* operator()(const std::basic_string<Char, Traits, Alloc>& e) const { return e.data(); }
+};
+
+
+template <typename T, typename Predicate, typename Address = AutoPrefetch>
+T* FindIfPrefetch(ListSpan<T> span, Predicate&& pred, Address&& address = Address(), size_t distance = prefetch_detail::defaultDistance) {
+    prefetch_detail::PrefetchFirst<std::remove_const_t<T>>(span.begin(), span.end(), address, distance);
+    return span.FindIf(prefetch_detail::Prefetching<std::remove_const_t<T>>(span.end(), pred, address, distance));
+}
+
+template <typename T, typename Allocator, typename Predicate, typename Address = AutoPrefetch>
+T* FindIfPrefetch(List<T, Allocator>& list, Predicate&& pred, Address&& address = Address(), size_t distance = prefetch_detail::defaultDistance) {
+    return FindIfPrefetch(ListSpan<T>(list), pred, address, distance);
+}
+template <typename T, typename Allocator, typename Predicate, typename Address = AutoPrefetch>
+const T* FindIfPrefetch(const List<T, Allocator>& list, Predicate&& pred, Address&& address = Address(), size_t distance = prefetch_detail::defaultDistance) {
+    return FindIfPrefetch(ListView<T>(list), pred, address, distance);
+}
+
+//RemoveIf with the same look-ahead - the compaction writes behind the scan, so the elements ahead are still in place
+template <typename T, typename Allocator, typename Predicate, typename Address = AutoPrefetch>
+size_t RemoveIfPrefetch(List<T, Allocator>& list, Predicate&& pred, Address&& address = Address(), size_t distance = prefetch_detail::defaultDistance) {
+    prefetch_detail::PrefetchFirst<T>(list.begin(), list.end(), address, distance);
+    return list.RemoveIf(prefetch_detail::Prefetching<T>(list.end(), pred, address, distance));
+}
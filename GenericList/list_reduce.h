@@ -0,0 +1,356 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+#include "list_view.h"
+#include "list_pipeline.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define LIST_REDUCE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define LIST_TARGET_AVX2 //MSVC allows AVX2 intrinsics in any function, the runtime check decides if they run
+#else
+#define LIST_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define LIST_REDUCE_X86 0
+#endif
+
+//Aggregates over numeric Lists/ListViews: Sum, Min, Max, MinMax, ArgMin, ArgMax, Mean, Variance
+//float, double and int32_t elements use AVX2 kernels when the CPU supports them (checked once at runtime),
+//every other arithmetic type (and CPUs without AVX2) use unrolled multi-accumulator loops the compiler can vectorize.
+//Passing LazyExecution::Parallel splits big lists into one chunk per hardware thread.
+//Note: NaN elements give unspecified Min/Max results.
+
+//How floating point sums are accumulated by Mean and Variance
+enum class SumMode {
+    Fast,     //vectorized, several independent accumulators - fastest, rounding error grows with Count
+    Kahan,    //compensated summation - error independent of Count, ~4x slower
+    Pairwise  //recursive halving - error grows with log(Count), close to Fast speed
+};
+
+namespace reduce_detail {
+    //Default accumulator: wide enough that summing a List of int32_t/uint8_t/... can't overflow in practice
+    template <typename T>
+    using DefaultAcc = std::conditional_t<std::is_floating_point_v<T>, T,
+                       std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+    template <typename Acc, typename T>
+    using AccOrDefault = std::conditional_t<std::is_void_v<Acc>, DefaultAcc<T>, Acc>;
+
+    inline void ThrowIfEmpty(size_t count, const char* operation) {
+        if (count == 0) throw std::out_of_range(std::string("Cannot compute ") + operation + std::string(" of an empty list."));
+    }
+
+
+    //Scalar kernels - 4 independent accumulators break the dependency chain so the loop can be pipelined/vectorized
+    template <typename Acc, typename T>
+    Acc SumScalar(const T* first, const T* last) {
+        Acc acc[4] = { Acc(0), Acc(0), Acc(0), Acc(0) };
+        for (; last - first >= 4; first += 4) {
+            acc[0] += Acc(first[0]);
+            acc[1] += Acc(first[1]);
+            acc[2] += Acc(first[2]);
+            acc[3] += Acc(first[3]);
+        }
+        for (; first < last; ++first) acc[0] += Acc(*first);
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+    template <typename T, typename Compare>
+    T ExtremeScalar(const T* first, const T* last, Compare better) {
+        T best = *first;
+        for (++first; first < last; ++first) {
+            if (better(*first, best)) best = *first;
+        }
+        return best;
+    }
+
+
+#if LIST_REDUCE_X86
+    inline bool HasAvx2() {
+        static const bool has = []() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false; //OS must save the ymm registers
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2") != 0;
+#endif
+        }();
+        return has;
+    }
+
+    LIST_TARGET_AVX2 inline float SumAvx2(const float* first, const float* last) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        for (; last - first >= 16; first += 16) {
+            acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(first));
+            acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(first + 8));
+        }
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+        return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7])) + SumScalar<float>(first, last);
+    }
+
+    LIST_TARGET_AVX2 inline double SumAvx2(const double* first, const double* last) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        for (; last - first >= 8; first += 8) {
+            acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(first));
+            acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(first + 4));
+        }
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + SumScalar<double>(first, last);
+    }
+
+    //int32_t summed into 64-bit lanes, so it can't overflow
+    LIST_TARGET_AVX2 inline long long SumAvx2(const int32_t* first, const int32_t* last) {
+        __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+        for (; last - first >= 8; first += 8) {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+            acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+        }
+        alignas(32) long long lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SumScalar<long long>(first, last);
+    }
+
+    //Min (IsMax = false) or Max (IsMax = true) of a non-empty range
+    template <bool IsMax>
+    LIST_TARGET_AVX2 float ExtremeAvx2(const float* first, const float* last) {
+        if (last - first < 8) return ExtremeScalar(first, last, [](float a, float b) { return IsMax ? a > b : a < b; });
+
+        __m256 best = _mm256_loadu_ps(first);
+        for (first += 8; last - first >= 8; first += 8) {
+            const __m256 values = _mm256_loadu_ps(first);
+            best = IsMax ? _mm256_max_ps(best, values) : _mm256_min_ps(best, values);
+        }
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, best);
+        float result = ExtremeScalar(lanes, lanes + 8, [](float a, float b) { return IsMax ? a > b : a < b; });
+        for (; first < last; ++first) result = IsMax ? std::max(result, *first) : std::min(result, *first);
+        return result;
+    }
+
+    template <bool IsMax>
+    LIST_TARGET_AVX2 double ExtremeAvx2(const double* first, const double* last) {
+        if (last - first < 4) return ExtremeScalar(first, last, [](double a, double b) { return IsMax ? a > b : a < b; });
+
+        __m256d best = _mm256_loadu_pd(first);
+        for (first += 4; last - first >= 4; first += 4) {
+            const __m256d values = _mm256_loadu_pd(first);
+            best = IsMax ? _mm256_max_pd(best, values) : _mm256_min_pd(best, values);
+        }
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, best);
+        double result = ExtremeScalar(lanes, lanes + 4, [](double a, double b) { return IsMax ? a > b : a < b; });
+        for (; first < last; ++first) result = IsMax ? std::max(result, *first) : std::min(result, *first);
+        return result;
+    }
+
+    template <bool IsMax>
+    LIST_TARGET_AVX2 int32_t ExtremeAvx2(const int32_t* first, const int32_t* last) {
+        if (last - first < 8) return ExtremeScalar(first, last, [](int32_t a, int32_t b) { return IsMax ? a > b : a < b; });
+
+        __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        for (first += 8; last - first >= 8; first += 8) {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            best = IsMax ? _mm256_max_epi32(best, values) : _mm256_min_epi32(best, values);
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+        int32_t result = ExtremeScalar(lanes, lanes + 8, [](int32_t a, int32_t b) { return IsMax ? a > b : a < b; });
+        for (; first < last; ++first) result = IsMax ? std::max(result, *first) : std::min(result, *first);
+        return result;
+    }
+#endif
+
+    //Runtime-dispatched kernels over [first, last)
+    template <typename Acc, typename T>
+    Acc SumRange(const T* first, const T* last) {
+#if LIST_REDUCE_X86
+        constexpr bool vectorized = (std::is_same_v<T, float> || std::is_same_v<T, double>) ? std::is_same_v<Acc, T>
+                                  : std::is_same_v<T, int32_t> && std::is_same_v<Acc, long long>;
+        if constexpr (vectorized) {
+            if (HasAvx2()) return SumAvx2(first, last);
+        }
+#endif
+        return SumScalar<Acc>(first, last);
+    }
+
+    template <bool IsMax, typename T>
+    T ExtremeRange(const T* first, const T* last) {
+#if LIST_REDUCE_X86
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>) {
+            if (HasAvx2()) return ExtremeAvx2<IsMax>(first, last);
+        }
+#endif
+        return ExtremeScalar(first, last, [](const T& a, const T& b) { return IsMax ? a > b : a < b; });
+    }
+
+    //Runs kernel(chunkFirst, chunkLast) over every chunk and folds the chunk results with combine
+    template <typename Result, typename T, typename Kernel, typename Combine>
+    Result ReduceChunks(const T* first, const T* last, LazyExecution execution, Kernel&& kernel, Combine&& combine) {
+        const size_t chunks = lazy_detail::ChunkCount(execution, size_t(last - first));
+        if (chunks <= 1) return kernel(first, last);
+
+        List<Result> results;
+        lazy_detail::RunChunks(first, last, chunks, results, kernel);
+
+        Result result = results[0];
+        for (size_t i = 1; i < results.Count(); i++) {
+            result = combine(result, results[i]);
+        }
+        return result;
+    }
+
+
+    //Sum of func(e) over [first, last), accumulated in double according to mode
+    template <typename T, typename Func>
+    double SumOf(const T* first, const T* last, SumMode mode, Func&& func) {
+        if (mode == SumMode::Kahan) {
+            double sum = 0.0, compensation = 0.0;
+            for (; first < last; ++first) {
+                const double y = double(func(*first)) - compensation;
+                const double t = sum + y;
+                compensation = (t - sum) - y;
+                sum = t;
+            }
+            return sum;
+        }
+        if (mode == SumMode::Pairwise && last - first > 128) {
+            const T* middle = first + (last - first) / 2;
+            return SumOf(first, middle, mode, func) + SumOf(middle, last, mode, func);
+        }
+
+        double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+        for (; last - first >= 4; first += 4) {
+            acc[0] += double(func(first[0]));
+            acc[1] += double(func(first[1]));
+            acc[2] += double(func(first[2]));
+            acc[3] += double(func(first[3]));
+        }
+        for (; first < last; ++first) acc[0] += double(func(*first));
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+}
+
+
+//Sum of all elements, accumulated in Acc (default: T for floating point, 64-bit for integers) - Sum<double>(floats) widens
+template <typename Acc = void, typename T>
+reduce_detail::AccOrDefault<Acc, T> Sum(ListView<T> view, LazyExecution execution = LazyExecution::Sequential) {
+    static_assert(std::is_arithmetic_v<T>, "Sum requires an arithmetic element type");
+    using Result = reduce_detail::AccOrDefault<Acc, T>;
+
+    return reduce_detail::ReduceChunks<Result>(view.begin(), view.end(), execution,
+        [](const T* first, const T* last) { return reduce_detail::SumRange<Result>(first, last); },
+        [](Result a, Result b) { return a + b; });
+}
+
+template <typename T>
+T Min(ListView<T> view, LazyExecution execution = LazyExecution::Sequential) {
+    static_assert(std::is_arithmetic_v<T>, "Min requires an arithmetic element type");
+    reduce_detail::ThrowIfEmpty(view.Count(), "minimum");
+
+    return reduce_detail::ReduceChunks<T>(view.begin(), view.end(), execution,
+        [](const T* first, const T* last) { return reduce_detail::ExtremeRange<false>(first, last); },
+        [](T a, T b) { return std::min(a, b); });
+}
+
+template <typename T>
+T Max(ListView<T> view, LazyExecution execution = LazyExecution::Sequential) {
+    static_assert(std::is_arithmetic_v<T>, "Max requires an arithmetic element type");
+    reduce_detail::ThrowIfEmpty(view.Count(), "maximum");
+
+    return reduce_detail::ReduceChunks<T>(view.begin(), view.end(), execution,
+        [](const T* first, const T* last) { return reduce_detail::ExtremeRange<true>(first, last); },
+        [](T a, T b) { return std::max(a, b); });
+}
+
+//(Min, Max) - each chunk is read twice while still in cache, instead of the whole list twice
+template <typename T>
+std::pair<T, T> MinMax(ListView<T> view, LazyExecution execution = LazyExecution::Sequential) {
+    static_assert(std::is_arithmetic_v<T>, "MinMax requires an arithmetic element type");
+    reduce_detail::ThrowIfEmpty(view.Count(), "minimum/maximum");
+
+    return reduce_detail::ReduceChunks<std::pair<T, T>>(view.begin(), view.end(), execution,
+        [](const T* first, const T* last) {
+            const size_t blockSize = 4096;
+            std::pair<T, T> result(*first, *first);
+            for (; first < last; first += std::min(blockSize, size_t(last - first))) {
+                const T* blockLast = first + std::min(blockSize, size_t(last - first));
+                result.first = std::min(result.first, reduce_detail::ExtremeRange<false>(first, blockLast));
+                result.second = std::max(result.second, reduce_detail::ExtremeRange<true>(first, blockLast));
+            }
+            return result;
+        },
+        [](std::pair<T, T> a, std::pair<T, T> b) { return std::pair<T, T>(std::min(a.first, b.first), std::max(a.second, b.second)); });
+}
+
+//Index of the first minimum/maximum element: vectorized Min/Max, then a scan for its first occurrence
+template <typename T>
+size_t ArgMin(ListView<T> view, LazyExecution execution = LazyExecution::Sequential) {
+    const T min = Min(view, execution);
+    return size_t(view.Find(min) - view.begin());
+}
+
+template <typename T>
+size_t ArgMax(ListView<T> view, LazyExecution execution = LazyExecution::Sequential) {
+    const T max = Max(view, execution);
+    return size_t(view.Find(max) - view.begin());
+}
+
+template <typename T>
+double Mean(ListView<T> view, SumMode mode = SumMode::Pairwise) {
+    static_assert(std::is_arithmetic_v<T>, "Mean requires an arithmetic element type");
+    reduce_detail::ThrowIfEmpty(view.Count(), "mean");
+
+    const double sum = mode == SumMode::Fast ? double(Sum<double>(view))
+                                             : reduce_detail::SumOf(view.begin(), view.end(), mode, [](const T& e) { return e; });
+    return sum / double(view.Count());
+}
+
+//Population variance, two-pass (mean first, then squared deviations from it) to avoid catastrophic cancellation
+template <typename T>
+double Variance(ListView<T> view, SumMode mode = SumMode::Pairwise) {
+    const double mean = Mean(view, mode);
+    const double squares = reduce_detail::SumOf(view.begin(), view.end(), mode, [&](const T& e) {
+        const double deviation = double(e) - mean;
+        return deviation * deviation;
+    });
+    return squares / double(view.Count());
+}
+
+
+//List overloads - a List doesn't implicitly deduce as a ListView<T> argument
+template <typename Acc = void, typename T, typename Allocator>
+reduce_detail::AccOrDefault<Acc, T> Sum(const List<T, Allocator>& list, LazyExecution execution = LazyExecution::Sequential) { return Sum<Acc>(ListView<T>(list), execution); }
+template <typename T, typename Allocator>
+T Min(const List<T, Allocator>& list, LazyExecution execution = LazyExecution::Sequential) { return Min(ListView<T>(list), execution); }
+template <typename T, typename Allocator>
+T Max(const List<T, Allocator>& list, LazyExecution execution = LazyExecution::Sequential) { return Max(ListView<T>(list), execution); }
+template <typename T, typename Allocator>
+std::pair<T, T> MinMax(const List<T, Allocator>& list, LazyExecution execution = LazyExecution::Sequential) { return MinMax(ListView<T>(list), execution); }
+template <typename T, typename Allocator>
+size_t ArgMin(const List<T, Allocator>& list, LazyExecution execution = LazyExecution::Sequential) { return ArgMin(ListView<T>(list), execution); }
+template <typename T, typename Allocator>
+size_t ArgMax(const List<T, Allocator>& list, LazyExecution execution = LazyExecution::Sequential) { return ArgMax(ListView<T>(list), execution); }
+template <typename T, typename Allocator>
+double Mean(const List<T, Allocator>& list, SumMode mode = SumMode::Pairwise) { return Mean(ListView<T>(list), mode); }
+template <typename T, typename Allocator>
+double Variance(const List<T, Allocator>& list, SumMode mode = SumMode::Pairwise) { return Variance(ListView<T>(list), mode); }
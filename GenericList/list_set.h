@@ -0,0 +1,188 @@
+#pragma once
+
+#include <functional>
+
+#include "list.h"
+#include "list_view.h"
+
+//Set operations on sorted Lists/ListViews (sorted by the same comp), with std::set_* semantics for repeated elements.
+//Each one clears dest, reserves the largest possible result size once, then fills it in a single merge pass.
+//Returns the amount of elements written to dest.
+//dest may be one of the inputs (Union(a, b, a)): when a or b points into dest's buffer, the result is built in a separate
+//List and moved into dest at the end, otherwise dest is filled directly.
+
+namespace set_detail {
+    //Intersect switches to galloping search when one input is this many times bigger than the other
+    constexpr size_t gallopRatio = 32;
+
+    //First position in [first, last) that is not less than val: doubles the step until it passes val, then binary searches
+    //the last step - O(log distance) instead of O(log n), so walking the big list for every small element stays cheap
+    template <typename T, typename Compare>
+    const T* Gallop(const T* first, const T* last, const T& val, Compare& comp) {
+        size_t step = 1;
+        const T* low = first;
+        while (step < size_t(last - low) && comp(low[step], val)) {
+            low += step;
+            step *= 2;
+        }
+        return std::lower_bound(low, step < size_t(last - low) ? low + step : last, val, comp);
+    }
+
+    //True if a or b lies within dest's buffer - clearing dest would destroy the inputs
+    template <typename T, typename Allocator>
+    bool Aliases(ListView<T> a, ListView<T> b, const List<T, Allocator>& dest) {
+        std::less<const T*> less; //total order, also for pointers into unrelated buffers
+        auto overlaps = [&](ListView<T> v) { return v.Count() != 0 && less(v.begin(), dest.begin() + dest.Capacity()) && less(dest.begin(), v.end()); };
+        return overlaps(a) || overlaps(b);
+    }
+
+    //Runs fill on a separate List from dest's allocator, then moves the result into dest
+    template <typename T, typename Allocator, typename Fill>
+    size_t IntoSeparate(List<T, Allocator>& dest, Fill&& fill) {
+        List<T, Allocator> result(dest.GetAllocator());
+        const size_t count = fill(result);
+        dest = std::move(result);
+        return count;
+    }
+}
+
+
+//Every element of a and b, in order (equal elements: those from a first)
+template <typename T, typename Allocator, typename Compare = std::less<>>
+size_t Merge(ListView<T> a, ListView<T> b, List<T, Allocator>& dest, Compare comp = Compare()) {
+    if (set_detail::Aliases(a, b, dest)) return set_detail::IntoSeparate(dest, [&](List<T, Allocator>& result) { return Merge(a, b, result, comp); });
+    dest.Clear();
+    dest.Capacity(a.Count() + b.Count());
+
+    auto i = a.begin(), j = b.begin();
+    while (i < a.end() && j < b.end()) {
+        if (comp(*j, *i)) dest.Add(*j++);
+        else dest.Add(*i++);
+    }
+    while (i < a.end()) dest.Add(*i++);
+    while (j < b.end()) dest.Add(*j++);
+
+    return dest.Count();
+}
+
+//Elements of a or b - an element repeated m times in a and n in b appears max(m, n) times
+template <typename T, typename Allocator, typename Compare = std::less<>>
+size_t Union(ListView<T> a, ListView<T> b, List<T, Allocator>& dest, Compare comp = Compare()) {
+    if (set_detail::Aliases(a, b, dest)) return set_detail::IntoSeparate(dest, [&](List<T, Allocator>& result) { return Union(a, b, result, comp); });
+    dest.Clear();
+    dest.Capacity(a.Count() + b.Count());
+
+    auto i = a.begin(), j = b.begin();
+    while (i < a.end() && j < b.end()) {
+        if (comp(*i, *j)) dest.Add(*i++);
+        else if (comp(*j, *i)) dest.Add(*j++);
+        else {
+            dest.Add(*i++);
+            ++j;
+        }
+    }
+    while (i < a.end()) dest.Add(*i++);
+    while (j < b.end()) dest.Add(*j++);
+
+    return dest.Count();
+}
+
+//Elements of a also in b (copied from a) - min(m, n) times
+template <typename T, typename Allocator, typename Compare = std::less<>>
+size_t Intersect(ListView<T> a, ListView<T> b, List<T, Allocator>& dest, Compare comp = Compare()) {
+    if (set_detail::Aliases(a, b, dest)) return set_detail::IntoSeparate(dest, [&](List<T, Allocator>& result) { return Intersect(a, b, result, comp); });
+    dest.Clear();
+    dest.Capacity(std::min(a.Count(), b.Count()));
+
+    //very different sizes: gallop through the big list once per element of the small one
+    if (a.Count() * set_detail::gallopRatio < b.Count()) {
+        auto j = b.begin();
+        for (auto i = a.begin(); i < a.end() && j < b.end(); ++i) {
+            j = set_detail::Gallop(j, b.end(), *i, comp);
+            if (j < b.end() && !comp(*i, *j)) {
+                dest.Add(*i);
+                ++j;
+            }
+        }
+        return dest.Count();
+    }
+    if (b.Count() * set_detail::gallopRatio < a.Count()) {
+        auto i = a.begin();
+        for (auto j = b.begin(); j < b.end() && i < a.end(); ++j) {
+            i = set_detail::Gallop(i, a.end(), *j, comp);
+            if (i < a.end() && !comp(*j, *i)) {
+                dest.Add(*i);
+                ++i;
+            }
+        }
+        return dest.Count();
+    }
+
+    auto i = a.begin(), j = b.begin();
+    while (i < a.end() && j < b.end()) {
+        if (comp(*i, *j)) ++i;
+        else if (comp(*j, *i)) ++j;
+        else {
+            dest.Add(*i++);
+            ++j;
+        }
+    }
+
+    return dest.Count();
+}
+
+//Elements of a not in b - max(m - n, 0) times
+template <typename T, typename Allocator, typename Compare = std::less<>>
+size_t Difference(ListView<T> a, ListView<T> b, List<T, Allocator>& dest, Compare comp = Compare()) {
+    if (set_detail::Aliases(a, b, dest)) return set_detail::IntoSeparate(dest, [&](List<T, Allocator>& result) { return Difference(a, b, result, comp); });
+    dest.Clear();
+    dest.Capacity(a.Count());
+
+    auto i = a.begin(), j = b.begin();
+    while (i < a.end() && j < b.end()) {
+        if (comp(*i, *j)) dest.Add(*i++);
+        else if (comp(*j, *i)) ++j;
+        else {
+            ++i;
+            ++j;
+        }
+    }
+    while (i < a.end()) dest.Add(*i++);
+
+    return dest.Count();
+}
+
+//Elements in exactly one of a and b - |m - n| times
+template <typename T, typename Allocator, typename Compare = std::less<>>
+size_t SymmetricDifference(ListView<T> a, ListView<T> b, List<T, Allocator>& dest, Compare comp = Compare()) {
+    if (set_detail::Aliases(a, b, dest)) return set_detail::IntoSeparate(dest, [&](List<T, Allocator>& result) { return SymmetricDifference(a, b, result, comp); });
+    dest.Clear();
+    dest.Capacity(a.Count() + b.Count());
+
+    auto i = a.begin(), j = b.begin();
+    while (i < a.end() && j < b.end()) {
+        if (comp(*i, *j)) dest.Add(*i++);
+        else if (comp(*j, *i)) dest.Add(*j++);
+        else {
+            ++i;
+            ++j;
+        }
+    }
+    while (i < a.end()) dest.Add(*i++);
+    while (j < b.end()) dest.Add(*j++);
+
+    return dest.Count();
+}
+
+
+//List overloads - a List doesn't implicitly deduce as a ListView<T> argument
+template <typename T, typename AllocatorA, typename AllocatorB, typename Allocator, typename Compare = std::less<>>
+size_t Merge(const List<T, AllocatorA>& a, const List<T, AllocatorB>& b, List<T, Allocator>& dest, Compare comp = Compare()) { return Merge(ListView<T>(a), ListView<T>(b), dest, comp); }
+template <typename T, typename AllocatorA, typename AllocatorB, typename Allocator, typename Compare = std::less<>>
+size_t Union(const List<T, AllocatorA>& a, const List<T, AllocatorB>& b, List<T, Allocator>& dest, Compare comp = Compare()) { return Union(ListView<T>(a), ListView<T>(b), dest, comp); }
+template <typename T, typename AllocatorA, typename AllocatorB, typename Allocator, typename Compare = std::less<>>
+size_t Intersect(const List<T, AllocatorA>& a, const List<T, AllocatorB>& b, List<T, Allocator>& dest, Compare comp = Compare()) { return Intersect(ListView<T>(a), ListView<T>(b), dest, comp); }
+template <typename T, typename AllocatorA, typename AllocatorB, typename Allocator, typename Compare = std::less<>>
+size_t Difference(const List<T, AllocatorA>& a, const List<T, AllocatorB>& b, List<T, Allocator>& dest, Compare comp = Compare()) { return Difference(ListView<T>(a), ListView<T>(b), dest, comp); }
+template <typename T, typename AllocatorA, typename AllocatorB, typename Allocator, typename Compare = std::less<>>
+size_t SymmetricDifference(const List<T, AllocatorA>& a, const List<T, AllocatorB>& b, List<T, Allocator>& dest, Compare comp = Compare()) { return SymmetricDifference(ListView<T>(a), ListView<T>(b), dest, comp); }
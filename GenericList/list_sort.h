@@ -0,0 +1,623 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "list.h"
+#include "list_pipeline.h"
+
+//Sorting algorithms behind List::Sort, List::StableSort and List::SortByKey.
+//
+//Arithmetic element types and integer/floating point keys use an LSD radix sort: one byte per pass, lowest byte first,
+//each pass is stable so the final order is by the full key. Passes where every key has the same byte are skipped.
+//With LazyExecution::Parallel, each pass builds one histogram per chunk, and every chunk then scatters into its own
+//precomputed slice of each bucket, so the result is identical to the sequential one.
+//
+//Comparison sorts use pattern-defeating quicksort (pdqsort, Orson Peters): median-of-3/ninther pivots, a branchless
+//block partition (BlockQuicksort) for trivially copyable elements, partial insertion sort to finish already partitioned
+//ranges in O(n), shuffling on unbalanced partitions and heapsort past a depth limit (O(n log n) worst case).
+//Small ranges of trivially copyable elements use a sorting network (no data-dependent branches), others insertion sort.
+//Input that is one ascending or strictly descending run is detected up front and handled in O(n).
+//StableSort is a bottom-up merge sort that borrows a half-size buffer from the list's allocator.
+template <typename T>
+struct ListSort {
+    //Below this, a comparison sort beats the fixed cost of the radix passes
+    static constexpr size_t minRadixCount = 1024;
+
+    static constexpr size_t insertionSortThreshold = 24;
+    static constexpr size_t networkThreshold = 32;
+    static constexpr size_t nintherThreshold = 128;
+    static constexpr size_t partialInsertionSortLimit = 8;
+    static constexpr size_t blockSize = 64; //elements classified per branchless partition block (offsets fit in a byte)
+    static constexpr size_t mergeRunSize = 32;
+
+    //Moving/copying is cheap and can't throw, so branchless code paths (networks, block partition) are worth it
+    static constexpr bool cheapElements = std::is_trivially_copyable_v<T> && sizeof(T) <= 16;
+
+    template <typename Key>
+    using KeyBits = std::conditional_t<sizeof(Key) == 1, uint8_t,
+                    std::conditional_t<sizeof(Key) == 2, uint16_t,
+                    std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>>>;
+
+    //Maps a key to unsigned bits with the same ordering:
+    //signed integers flip the sign bit, floating point flips the sign bit of positives and every bit of negatives (-0.0 sorts before 0.0, NaNs at the ends)
+    template <typename Key>
+    static KeyBits<Key> ToSortableBits(Key key) {
+        static_assert(std::is_arithmetic_v<Key>, "sort keys must be arithmetic");
+        static_assert(sizeof(Key) <= 8, "sort keys wider than 64 bits (eg: 80-bit long double) have no sortable bits mapping");
+        using Bits = KeyBits<Key>;
+        constexpr Bits signBit = Bits(Bits(1) << (sizeof(Bits) * 8 - 1));
+
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof(Bits));
+
+        if constexpr (std::is_floating_point_v<Key>) return Bits(bits ^ ((bits & signBit) ? Bits(~Bits(0)) : signBit));
+        else if constexpr (std::is_signed_v<Key>) return Bits(bits ^ signBit);
+        else return bits;
+    }
+
+
+    //Unstable sort by comp
+    template <typename Compare>
+    static void Introsort(T* first, T* last, Compare& comp) {
+        const size_t count = size_t(last - first);
+        if (count < 2) return;
+
+        if (SortRun(first, last, comp)) return;
+
+        size_t depth = 0;
+        for (size_t n = count; n > 1; n >>= 1) ++depth;
+        PdqLoop(first, last, comp, depth, true);
+    }
+
+    //Stable sort by comp
+    template <typename Allocator, typename Compare>
+    static void MergeSort(T* data, size_t count, Allocator& alloc, Compare& comp) {
+        if (count < 2) return;
+
+        if (SortRun(data, data + count, comp)) return;
+
+        for (size_t lo = 0; lo < count; lo += mergeRunSize) {
+            InsertionSort(data + lo, data + std::min(lo + mergeRunSize, count), comp);
+        }
+        if (count <= mergeRunSize) return;
+
+        //the buffer only ever holds the smaller half of a merge
+        const size_t bufferSize = (count + 1) / 2;
+        T* buffer = alloc.allocate(bufferSize);
+
+        for (size_t width = mergeRunSize; width < count; width *= 2) {
+            for (size_t lo = 0; lo + width < count; lo += 2 * width) {
+                Merge(data + lo, data + lo + width, data + std::min(lo + 2 * width, count), buffer, comp);
+            }
+        }
+
+        alloc.deallocate(buffer, bufferSize);
+    }
+
+    //Sorts arithmetic elements by value - types wider than 64 bits (long double) use the comparison sort
+    template <typename Allocator>
+    static void Radix(T* data, size_t count, Allocator& alloc, LazyExecution execution) {
+        static_assert(std::is_arithmetic_v<T>, "Radix requires an arithmetic element type");
+        if (sizeof(T) > 8 || count < minRadixCount) {
+            std::less<> comp;
+            Introsort(data, data + count, comp);
+            return;
+        }
+
+        if constexpr (sizeof(T) <= 8) {
+            T* scratch = alloc.allocate(count);
+            RadixPasses(data, scratch, count, [](const T& e) { return ToSortableBits(e); }, execution);
+            alloc.deallocate(scratch, count);
+        }
+    }
+
+    //Stable sort of any element type by an arithmetic key: (key bits, index) pairs are radix sorted, then the elements are moved once into place.
+    //Keys wider than 64 bits (long double) fall back to a merge sort comparing the keys.
+    template <typename Allocator, typename KeyFunc>
+    static void RadixByKey(T* data, size_t count, Allocator& alloc, KeyFunc& key, LazyExecution execution) {
+        using Key = std::decay_t<decltype(key(*data))>;
+        if constexpr (sizeof(Key) > 8) {
+            auto comp = [&key](const T& a, const T& b) { return key(a) < key(b); };
+            MergeSort(data, count, alloc, comp);
+        }
+        else {
+            RadixByKeyBits(data, count, alloc, key, execution);
+        }
+    }
+
+
+
+private:
+    template <typename Allocator, typename KeyFunc>
+    static void RadixByKeyBits(T* data, size_t count, Allocator& alloc, KeyFunc& key, LazyExecution execution) {
+        using Bits = decltype(ToSortableBits(key(*data)));
+        struct Entry {
+            Bits bits;
+            size_t index;
+        };
+
+        if (count < 2) return;
+
+        using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+        EntryAllocator entryAlloc(alloc);
+        Entry* entries = entryAlloc.allocate(count);
+        Entry* scratch = entryAlloc.allocate(count);
+        for (size_t i = 0; i < count; i++) {
+            entries[i] = Entry{ ToSortableBits(key(data[i])), i };
+        }
+
+        RadixPasses(entries, scratch, count, [](const Entry& e) { return e.bits; }, execution);
+
+        //gather into raw storage from the list's allocator, then move back
+        T* sorted = alloc.allocate(count);
+        for (size_t i = 0; i < count; i++) {
+            new (sorted + i) T(std::move(data[entries[i].index]));
+        }
+        for (size_t i = 0; i < count; i++) {
+            data[i] = std::move(sorted[i]);
+            sorted[i].~T();
+        }
+
+        alloc.deallocate(sorted, count);
+        entryAlloc.deallocate(scratch, count);
+        entryAlloc.deallocate(entries, count);
+    }
+
+    using Histogram = std::array<size_t, 256>;
+
+    //If [first, last) is a single ascending run (or strictly descending one, reversed in place - keeps stability) sorts it and returns true
+    template <typename Compare>
+    static bool SortRun(T* first, T* last, Compare& comp) {
+        T* runEnd = first + 1;
+        if (comp(*runEnd, *first)) {
+            while (runEnd < last && comp(*runEnd, *(runEnd - 1))) ++runEnd;
+            if (runEnd != last) return false;
+            std::reverse(first, last);
+            return true;
+        }
+
+        while (runEnd < last && !comp(*runEnd, *(runEnd - 1))) ++runEnd;
+        return runEnd == last;
+    }
+
+
+    template <typename Compare>
+    static void Sort2(T* a, T* b, Compare& comp) {
+        if (comp(*b, *a)) std::iter_swap(a, b);
+    }
+
+    template <typename Compare>
+    static void Sort3(T* a, T* b, T* c, Compare& comp) {
+        Sort2(a, b, comp);
+        Sort2(b, c, comp);
+        Sort2(a, b, comp);
+    }
+
+    template <typename Compare>
+    static void InsertionSort(T* first, T* last, Compare& comp) {
+        if (first == last) return;
+
+        for (T* cur = first + 1; cur < last; ++cur) {
+            if (comp(*cur, *(cur - 1))) {
+                T tmp(std::move(*cur));
+                T* sift = cur;
+                do {
+                    *sift = std::move(*(sift - 1));
+                    --sift;
+                } while (sift != first && comp(tmp, *(sift - 1)));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    //Insertion sort without the bounds check: *(first - 1) is known to be <= every element of [first, last)
+    template <typename Compare>
+    static void UnguardedInsertionSort(T* first, T* last, Compare& comp) {
+        for (T* cur = first + 1; cur < last; ++cur) {
+            if (comp(*cur, *(cur - 1))) {
+                T tmp(std::move(*cur));
+                T* sift = cur;
+                do {
+                    *sift = std::move(*(sift - 1));
+                    --sift;
+                } while (comp(tmp, *(sift - 1)));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    //Insertion sort that gives up (returns false) after partialInsertionSortLimit element moves
+    template <typename Compare>
+    static bool PartialInsertionSort(T* first, T* last, Compare& comp) {
+        if (first == last) return true;
+
+        size_t moves = 0;
+        for (T* cur = first + 1; cur < last; ++cur) {
+            if (moves > partialInsertionSortLimit) return false;
+
+            if (comp(*cur, *(cur - 1))) {
+                T tmp(std::move(*cur));
+                T* sift = cur;
+                do {
+                    *sift = std::move(*(sift - 1));
+                    --sift;
+                } while (sift != first && comp(tmp, *(sift - 1)));
+                *sift = std::move(tmp);
+                moves += size_t(cur - sift);
+            }
+        }
+        return true;
+    }
+
+    //Batcher's odd-even merge sort network for any n: the sequence of compare-exchanges doesn't depend on the data,
+    //and each one compiles to conditional moves instead of branches
+    template <typename Compare>
+    static void SortingNetwork(T* data, size_t n, Compare& comp) {
+        for (size_t p = 1; p < n; p <<= 1) {
+            for (size_t k = p; k >= 1; k >>= 1) {
+                for (size_t j = k % p; j + k < n; j += 2 * k) {
+                    for (size_t i = 0; i < std::min(k, n - j - k); i++) {
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                            T& x = data[i + j];
+                            T& y = data[i + j + k];
+                            const T a = x, b = y;
+                            const bool swap = comp(b, a);
+                            x = swap ? b : a;
+                            y = swap ? a : b;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+
+    //Partitions [first, last) around *first: returns the pivot's final position, and whether the range was already partitioned
+    template <typename Compare>
+    static std::pair<T*, bool> PartitionRight(T* first, T* last, Compare& comp) {
+        T* const begin = first;
+        T pivot(std::move(*first));
+
+        //elements equal to the pivot go right - the pivot is the median of 3, so these loops are guarded by it
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) {
+            while (first < last && !comp(*--last, pivot));
+        }
+        else {
+            while (!comp(*--last, pivot));
+        }
+
+        const bool alreadyPartitioned = first >= last;
+
+        while (first < last) {
+            std::iter_swap(first, last);
+            while (comp(*++first, pivot));
+            while (!comp(*--last, pivot));
+        }
+
+        T* pivotPos = first - 1;
+        *begin = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return std::make_pair(pivotPos, alreadyPartitioned);
+    }
+
+    //Swaps elements at the offsets found by PartitionRightBranchless - as a cycle of moves unless both blocks are full
+    static void SwapOffsets(T* first, T* last, const unsigned char* offsetsL, const unsigned char* offsetsR, size_t num, bool useSwaps) {
+        if (useSwaps) {
+            //needed for descending input, where the cycle would break pdqsort's O(n) guarantee
+            for (size_t i = 0; i < num; ++i) {
+                std::iter_swap(first + offsetsL[i], last - offsetsR[i]);
+            }
+        }
+        else if (num > 0) {
+            T* l = first + offsetsL[0];
+            T* r = last - offsetsR[0];
+            T tmp(std::move(*l));
+            *l = std::move(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = first + offsetsL[i];
+                *r = std::move(*l);
+                r = last - offsetsR[i];
+                *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
+    }
+
+    //Same contract as PartitionRight. Comparisons only produce offsets (no branch on their result), and the
+    //misplaced elements of a left block and a right block are then swapped in bulk
+    template <typename Compare>
+    static std::pair<T*, bool> PartitionRightBranchless(T* first, T* last, Compare& comp) {
+        T* const begin = first;
+        T pivot(std::move(*first));
+
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) {
+            while (first < last && !comp(*--last, pivot));
+        }
+        else {
+            while (!comp(*--last, pivot));
+        }
+
+        const bool alreadyPartitioned = first >= last;
+
+        if (!alreadyPartitioned) {
+            std::iter_swap(first, last);
+            ++first;
+
+            alignas(64) unsigned char offsetsL[blockSize];
+            alignas(64) unsigned char offsetsR[blockSize];
+
+            T* offsetsLBase = first;
+            T* offsetsRBase = last;
+            size_t numL = 0, numR = 0, startL = 0, startR = 0;
+
+            while (first < last) {
+                //size the blocks to fill: a full block if possible, otherwise split what's left between the empty sides
+                const size_t numUnknown = size_t(last - first);
+                const size_t leftSplit = numL == 0 ? (numR == 0 ? numUnknown / 2 : numUnknown) : 0;
+                const size_t rightSplit = numR == 0 ? (numUnknown - leftSplit) : 0;
+
+                const size_t leftAmount = std::min(leftSplit, blockSize);
+                for (size_t i = 0; i < leftAmount; ) {
+                    offsetsL[numL] = (unsigned char)(i++);
+                    numL += !comp(*first, pivot);
+                    ++first;
+                }
+
+                const size_t rightAmount = std::min(rightSplit, blockSize);
+                for (size_t i = 0; i < rightAmount; ) {
+                    offsetsR[numR] = (unsigned char)(++i);
+                    numR += comp(*--last, pivot);
+                }
+
+                const size_t num = std::min(numL, numR);
+                SwapOffsets(offsetsLBase, offsetsRBase, offsetsL + startL, offsetsR + startR, num, numL == numR);
+                numL -= num;
+                numR -= num;
+                startL += num;
+                startR += num;
+
+                if (numL == 0) {
+                    startL = 0;
+                    offsetsLBase = first;
+                }
+                if (numR == 0) {
+                    startR = 0;
+                    offsetsRBase = last;
+                }
+            }
+
+            //one side still has misplaced elements - swap them to the border
+            if (numL) {
+                while (numL--) std::iter_swap(offsetsLBase + offsetsL[startL + numL], --last);
+                first = last;
+            }
+            if (numR) {
+                while (numR--) std::iter_swap(offsetsRBase - offsetsR[startR + numR], first), ++first;
+                last = first;
+            }
+        }
+
+        T* pivotPos = first - 1;
+        *begin = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return std::make_pair(pivotPos, alreadyPartitioned);
+    }
+
+    //Partitions [first, last) around *first, putting elements equal to the pivot left.
+    //Used when the pivot equals the element before the range: everything equal to it is then in its final place
+    template <typename Compare>
+    static T* PartitionLeft(T* first, T* last, Compare& comp) {
+        T* const begin = first;
+        T* const end = last;
+        T pivot(std::move(*first));
+
+        while (comp(pivot, *--last));
+        if (last + 1 == end) {
+            while (first < last && !comp(pivot, *++first));
+        }
+        else {
+            while (!comp(pivot, *++first));
+        }
+
+        while (first < last) {
+            std::iter_swap(first, last);
+            while (comp(pivot, *--last));
+            while (!comp(pivot, *++first));
+        }
+
+        T* pivotPos = last;
+        *begin = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return pivotPos;
+    }
+
+    //pdqsort main loop - recurses on the left partition, loops on the right one
+    template <typename Compare>
+    static void PdqLoop(T* begin, T* end, Compare& comp, size_t badAllowed, bool leftmost) {
+        while (true) {
+            const size_t size = size_t(end - begin);
+
+            if (cheapElements && size <= networkThreshold) {
+                SortingNetwork(begin, size, comp);
+                return;
+            }
+            if (size < insertionSortThreshold) {
+                if (leftmost) InsertionSort(begin, end, comp);
+                else UnguardedInsertionSort(begin, end, comp);
+                return;
+            }
+
+            //pivot: median of 3, or pseudo-median of 9 for big ranges - moved to *begin
+            const size_t half = size / 2;
+            if (size > nintherThreshold) {
+                Sort3(begin, begin + half, end - 1, comp);
+                Sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                Sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                Sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                std::iter_swap(begin, begin + half);
+            }
+            else {
+                Sort3(begin + half, begin, end - 1, comp);
+            }
+
+            //the element before this range is <= everything in it: if it equals the pivot, so do all elements
+            //that partition left - they're done, only the right side still needs sorting (makes few-unique inputs O(n))
+            if (!leftmost && !comp(*(begin - 1), *begin)) {
+                begin = PartitionLeft(begin, end, comp) + 1;
+                continue;
+            }
+
+            const auto partition = cheapElements ? PartitionRightBranchless(begin, end, comp) : PartitionRight(begin, end, comp);
+            T* pivotPos = partition.first;
+            const bool alreadyPartitioned = partition.second;
+
+            const size_t leftSize = size_t(pivotPos - begin);
+            const size_t rightSize = size_t(end - (pivotPos + 1));
+            const bool highlyUnbalanced = leftSize < size / 8 || rightSize < size / 8;
+
+            if (highlyUnbalanced) {
+                //too many bad pivots - switch to heapsort to keep O(n log n)
+                if (--badAllowed == 0) {
+                    std::make_heap(begin, end, comp);
+                    std::sort_heap(begin, end, comp);
+                    return;
+                }
+
+                //break up patterns that produce bad pivots by swapping a few elements around
+                if (leftSize >= insertionSortThreshold) {
+                    std::iter_swap(begin, begin + leftSize / 4);
+                    std::iter_swap(pivotPos - 1, pivotPos - leftSize / 4);
+                    if (leftSize > nintherThreshold) {
+                        std::iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+                        std::iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+                        std::iter_swap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+                        std::iter_swap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+                    }
+                }
+                if (rightSize >= insertionSortThreshold) {
+                    std::iter_swap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+                    std::iter_swap(end - 1, end - rightSize / 4);
+                    if (rightSize > nintherThreshold) {
+                        std::iter_swap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+                        std::iter_swap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+                        std::iter_swap(end - 2, end - (1 + rightSize / 4));
+                        std::iter_swap(end - 3, end - (2 + rightSize / 4));
+                    }
+                }
+            }
+            else if (alreadyPartitioned && PartialInsertionSort(begin, pivotPos, comp) && PartialInsertionSort(pivotPos + 1, end, comp)) {
+                //no element moved during partitioning: probably (nearly) sorted, try to finish with cheap insertion sorts
+                return;
+            }
+
+            PdqLoop(begin, pivotPos, comp, badAllowed, leftmost);
+            begin = pivotPos + 1;
+            leftmost = false;
+        }
+    }
+
+
+    //Merges sorted [lo, mid) and [mid, hi) through buffer (raw storage for min(mid - lo, hi - mid) elements)
+    template <typename Compare>
+    static void Merge(T* lo, T* mid, T* hi, T* buffer, Compare& comp) {
+        if (!comp(*mid, *(mid - 1))) return; //already in order
+
+        if (mid - lo <= hi - mid) {
+            //left half into the buffer, merge forward
+            T* bufferEnd = buffer;
+            for (T* src = lo; src < mid; ++src, ++bufferEnd) new (bufferEnd) T(std::move(*src));
+
+            T* out = lo;
+            T* l = buffer;
+            T* r = mid;
+            while (l < bufferEnd && r < hi) {
+                if (comp(*r, *l)) *out++ = std::move(*r++);
+                else *out++ = std::move(*l++);
+            }
+            while (l < bufferEnd) *out++ = std::move(*l++);
+
+            DestroyBuffer(buffer, bufferEnd);
+        }
+        else {
+            //right half into the buffer, merge backward
+            T* bufferEnd = buffer;
+            for (T* src = mid; src < hi; ++src, ++bufferEnd) new (bufferEnd) T(std::move(*src));
+
+            T* out = hi;
+            T* l = mid;
+            T* r = bufferEnd;
+            while (l > lo && r > buffer) {
+                if (comp(*(r - 1), *(l - 1))) *--out = std::move(*--l);
+                else *--out = std::move(*--r);
+            }
+            while (r > buffer) *--out = std::move(*--r);
+
+            DestroyBuffer(buffer, bufferEnd);
+        }
+    }
+
+    static void DestroyBuffer(T* first, T* last) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (; first < last; ++first) first->~T();
+        }
+    }
+
+    //LSD radix sort of trivially copyable elements, result ends in data (scratch must hold count elements)
+    template <typename E, typename BitsOf>
+    static void RadixPasses(E* data, E* scratch, size_t count, BitsOf bitsOf, LazyExecution execution) {
+        using Bits = decltype(bitsOf(*data));
+        constexpr size_t passes = sizeof(Bits);
+
+        const size_t chunks = lazy_detail::ChunkCount(execution, count);
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+
+        E* src = data;
+        E* dst = scratch;
+        for (size_t pass = 0; pass < passes; pass++) {
+            const size_t shift = pass * 8;
+
+            //one histogram per chunk
+            List<Histogram> histograms;
+            lazy_detail::RunChunks(src, src + count, chunks, histograms, [&](const E* first, const E* last) {
+                Histogram histogram{};
+                for (; first < last; ++first) ++histogram[(bitsOf(*first) >> shift) & 0xFF];
+                return histogram;
+            });
+
+            //skip passes where every key has the same byte - common for small values in wide types
+            size_t totalFirstBucket = 0;
+            for (const auto& histogram : histograms) totalFirstBucket += histogram[(bitsOf(*src) >> shift) & 0xFF];
+            if (totalFirstBucket == count) continue;
+
+            //bucket-major, chunk-minor prefix sum: chunk c writes bucket b right after chunks < c wrote theirs
+            size_t offset = 0;
+            for (size_t bucket = 0; bucket < 256; bucket++) {
+                for (auto& histogram : histograms) {
+                    const size_t amount = histogram[bucket];
+                    histogram[bucket] = offset;
+                    offset += amount;
+                }
+            }
+
+            List<bool> done;
+            lazy_detail::RunChunks(src, src + count, chunks, done, [&](const E* first, const E* last) {
+                if (first == last) return true;
+                Histogram& offsets = histograms[size_t(first - src) / chunkSize];
+                for (; first < last; ++first) {
+                    dst[offsets[(bitsOf(*first) >> shift) & 0xFF]++] = *first;
+                }
+                return true;
+            });
+
+            std::swap(src, dst);
+        }
+
+        if (src != data) std::memcpy(data, src, count * sizeof(E));
+    }
+};
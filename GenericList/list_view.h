@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "list.h"
+
+//Non-owning window over contiguous elements (a List, part of a List, a raw array, any pointer + count buffer).
+//Never allocates or copies elements - the viewed buffer must outlive the span, and any List operation that
+//reallocates (Add past Capacity, Resize, ShrinkToFit) or removes elements invalidates spans over it.
+//ListSpan<T> allows writing through to the elements, ListView<T> (= ListSpan<const T>) is read-only.
+template <typename T>
+class ListSpan {
+    static_assert(!std::is_reference_v<T>, "reference type is not allowed");
+
+    template <typename U>
+    using IsCompatible = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>, int>; //same rule as std::span: allows T -> const T only
+
+public:
+    ListSpan() : data(nullptr), count(0) {
+
+    }
+
+    ListSpan(T* data, size_t count) : data(data), count(count) {
+
+    }
+
+    template <size_t N>
+    ListSpan(T(&array)[N]) : data(array), count(N) {
+
+    }
+
+    template <typename U, typename Allocator, IsCompatible<U> = 0>
+    ListSpan(List<U, Allocator>& list) : data(list.begin()), count(list.Count()) {
+
+    }
+
+    template <typename U, typename Allocator, IsCompatible<const U> = 0>
+    ListSpan(const List<U, Allocator>& list) : data(list.begin()), count(list.Count()) {
+
+    }
+
+    //ListSpan<T> -> ListView<T>
+    template <typename U, IsCompatible<U> = 0>
+    ListSpan(const ListSpan<U>& other) : data(other.begin()), count(other.Count()) {
+
+    }
+
+
+    size_t Count() const { return count; }
+    bool IsEmpty() const { return count == 0; }
+
+    //Sub-window [offset, offset + len), clamped to the end of this span - offset itself must be within it
+    ListSpan Slice(size_t offset, size_t len) const {
+        if (offset > count) throw std::out_of_range(std::string("Cannot slice at out_of_range offset: ") + std::to_string(offset) + std::string("."));
+
+        return ListSpan(data + offset, std::min(len, count - offset));
+    }
+    ListSpan Slice(size_t offset) const { return Slice(offset, count); }
+
+
+    template <typename U>
+    T* Find(const U& val) const {
+        for (size_t i = 0; i < count; i++) {
+            if (data[i] == val) return data + i;
+        }
+        return nullptr;
+    }
+
+    template <typename Predicate>
+    T* FindIf(Predicate&& pred) const {
+        for (auto ptr = begin(); ptr < end(); ptr++) {
+            if (pred(*ptr)) return ptr;
+        }
+        return nullptr;
+    }
+
+    //Amount of elements equal to val (Count() without argument is the span length)
+    template <typename U>
+    size_t Count(const U& val) const {
+        return CountIf([&](const auto& e) { return e == val; });
+    }
+
+    template <typename Predicate>
+    size_t CountIf(Predicate&& pred) const {
+        size_t matches = 0;
+        for (auto ptr = begin(); ptr < end(); ptr++) {
+            if (pred(*ptr)) ++matches;
+        }
+        return matches;
+    }
+
+    //a span is a reference - constness of the span doesn't propagate to the elements (same as a pointer)
+    T& operator[](size_t index) const { return data[index]; }
+    T& Get(size_t index) const {
+        if (index >= count) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return data[index];
+    }
+
+    T* begin() const { return data; }
+    T* end() const { return data + count; }
+    const T* cbegin() const { return data; }
+    const T* cend() const { return data + count; }
+
+    LazyList<std::remove_const_t<T>> Lazy() const { return LazyList<std::remove_const_t<T>>(begin(), end()); }
+
+    //Copies the viewed elements into a new List
+    List<std::remove_const_t<T>> ToList() const {
+        List<std::remove_const_t<T>> list;
+        list.Capacity(count);
+        for (const auto& e : *this) {
+            list.Add(e);
+        }
+        return list;
+    }
+
+
+
+private:
+    T* data;
+    size_t count;
+};
+
+template <typename T>
+using ListView = ListSpan<const T>;
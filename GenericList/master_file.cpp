@@ -2,13 +2,20 @@
 //
 
 #include <iostream>
+#include <string>
 
 #include "list.h"
 #include "string_list.h"
+#include "list_benchmark.h"
 
-int main()
+//Pass --benchmark to also run the (slow) list benchmarks
+int main(int argc, char* argv[])
 {    
     Main_Test_List_String();
+
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--benchmark") Main_Benchmark_List();
+    }
 }
 
 // Run program: Ctrl + F5 or Debug > Start Without Debugging menu
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+#include "bit_list.h"
+
+namespace packed_detail {
+    constexpr size_t blockSize = 128;
+
+    using Unpacker = void (*)(const uint64_t* in, uint64_t* out);
+
+    //Unpacks blockSize values of Bits bits each - Bits is a constant so the shifts/masks fold and the loop unrolls/vectorizes
+    template <unsigned Bits>
+    void UnpackBlock(const uint64_t* in, uint64_t* out) {
+        if constexpr (Bits == 0) {
+            std::fill(out, out + blockSize, uint64_t(0));
+        }
+        else {
+            constexpr uint64_t mask = Bits == 64 ? ~uint64_t(0) : (uint64_t(1) << Bits) - 1;
+            for (unsigned j = 0; j < blockSize; j++) {
+                const unsigned bit = j * Bits;
+                const unsigned shift = bit % 64;
+                uint64_t value = in[bit / 64] >> shift;
+                if (shift + Bits > 64) value |= in[bit / 64 + 1] << (64 - shift);
+                out[j] = value & mask;
+            }
+        }
+    }
+
+    template <size_t... Bits>
+    constexpr std::array<Unpacker, sizeof...(Bits)> MakeUnpackers(std::index_sequence<Bits...>) {
+        return { { &UnpackBlock<unsigned(Bits)>... } };
+    }
+
+    inline Unpacker GetUnpacker(unsigned bits) {
+        static constexpr std::array<Unpacker, 65> unpackers = MakeUnpackers(std::make_index_sequence<65>());
+        return unpackers[bits];
+    }
+
+    //Single value j of a block, without unpacking the rest
+    inline uint64_t Extract(const uint64_t* in, size_t j, unsigned bits) {
+        if (bits == 0) return 0;
+        const size_t bit = j * bits;
+        const unsigned shift = unsigned(bit % 64);
+        uint64_t value = in[bit / 64] >> shift;
+        if (shift + bits > 64) value |= in[bit / 64 + 1] << (64 - shift);
+        return bits == 64 ? value : value & ((uint64_t(1) << bits) - 1);
+    }
+
+    //Appends blockSize values of bits bits each - exactly 2 * bits words
+    inline void Pack(const uint64_t* values, unsigned bits, List<uint64_t>& words) {
+        const size_t first = words.Count();
+        for (unsigned i = 0; i < 2 * bits; i++) words.Add(uint64_t(0));
+        uint64_t* out = words.begin() + first;
+        for (size_t j = 0; j < blockSize && bits != 0; j++) {
+            const size_t bit = j * bits;
+            const unsigned shift = unsigned(bit % 64);
+            out[bit / 64] |= values[j] << shift;
+            if (shift + bits > 64) out[bit / 64 + 1] |= values[j] >> (64 - shift);
+        }
+    }
+}
+
+//Compressed List of unsigned integers for large, mostly sorted ID lists.
+//Values are stored in blocks of 128, each bit-packed at the width of its largest entry: non-decreasing blocks as deltas
+//from their first value, others as offsets from their minimum (frame of reference). Every block keeps a min/max
+//header, so Find and LowerBound only decode blocks that can hold the value. The last, incomplete block stays unpacked.
+//Append-only: Add, Get, Find, LowerBound and block-wise iteration (ForEach).
+template <typename T>
+class PackedIntList {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value, "PackedIntList holds unsigned integers");
+
+    struct Block {
+        T min;
+        T max;
+        size_t offset; //first word in words
+        uint8_t bits;
+        bool delta;
+    };
+
+public:
+    static constexpr size_t npos = size_t(-1);
+    static constexpr size_t blockSize = packed_detail::blockSize;
+
+    PackedIntList() {
+
+    }
+
+
+    size_t Count() const { return blocks.Count() * blockSize + tail.Count(); }
+    bool IsEmpty() const { return Count() == 0; }
+    size_t BlockCount() const { return blocks.Count(); }
+    //Bytes used by the packed words, block headers and the unpacked tail
+    size_t MemoryBytes() const { return words.Count() * sizeof(uint64_t) + blocks.Count() * sizeof(Block) + tail.Count() * sizeof(T); }
+
+    void Clear() {
+        words.Clear();
+        blocks.Clear();
+        tail.Clear();
+    }
+
+    void Add(T value) {
+        tail.Add(value);
+        if (tail.Count() == blockSize) Seal();
+    }
+
+    T operator[](size_t index) const {
+        const size_t block = index / blockSize;
+        if (block == blocks.Count()) return tail[index % blockSize];
+
+        const Block& header = blocks[block];
+        const uint64_t* in = words.begin() + header.offset;
+        if (!header.delta) return T(header.min + packed_detail::Extract(in, index % blockSize, header.bits));
+
+        //deltas need the prefix sum up to the element
+        uint64_t value = header.min;
+        for (size_t j = 1; j <= index % blockSize; j++) value += packed_detail::Extract(in, j, header.bits);
+        return T(value);
+    }
+    T Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    //Decodes the values of block into out (blockSize values, or the tail's count for the last, incomplete block)
+    size_t DecodeBlock(size_t block, T* out) const {
+        if (block == blocks.Count()) {
+            std::copy(tail.begin(), tail.end(), out);
+            return tail.Count();
+        }
+
+        const Block& header = blocks.Get(block);
+        uint64_t values[blockSize];
+        packed_detail::GetUnpacker(header.bits)(words.begin() + header.offset, values);
+        if (header.delta) {
+            uint64_t value = header.min;
+            for (size_t j = 0; j < blockSize; j++) {
+                value += values[j];
+                out[j] = T(value);
+            }
+        }
+        else {
+            for (size_t j = 0; j < blockSize; j++) out[j] = T(header.min + values[j]);
+        }
+        return blockSize;
+    }
+
+    //Calls func(value) for every element in order, a decoded block at a time
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        T values[blockSize];
+        for (size_t block = 0; block <= blocks.Count(); block++) {
+            const size_t n = DecodeBlock(block, values);
+            for (size_t j = 0; j < n; j++) func(values[j]);
+        }
+    }
+
+    //Index of the first element equal to val, npos if none - blocks whose [min, max] excludes val are skipped undecoded
+    size_t Find(T val) const {
+        T values[blockSize];
+        for (size_t block = 0; block < blocks.Count(); block++) {
+            if (val < blocks[block].min || val > blocks[block].max) continue;
+
+            DecodeBlock(block, values);
+            const T* found = std::find(values, values + blockSize, val);
+            if (found != values + blockSize) return block * blockSize + size_t(found - values);
+        }
+
+        const T* found = std::find(tail.begin(), tail.end(), val);
+        return found != tail.end() ? blocks.Count() * blockSize + size_t(found - tail.begin()) : npos;
+    }
+
+    bool Contains(T val) const {
+        return Find(val) != npos;
+    }
+
+    //Index of the first element not less than val (Count() if none) - the list must be sorted.
+    //Binary searches the block headers, then decodes a single block.
+    size_t LowerBound(T val) const {
+        const Block* block = std::partition_point(blocks.begin(), blocks.end(), [&](const Block& b) { return b.max < val; });
+        if (block == blocks.end()) return blocks.Count() * blockSize + size_t(std::lower_bound(tail.begin(), tail.end(), val) - tail.begin());
+
+        const size_t index = size_t(block - blocks.begin());
+        T values[blockSize];
+        DecodeBlock(index, values);
+        return index * blockSize + size_t(std::lower_bound(values, values + blockSize, val) - values);
+    }
+
+    List<T> ToList() const {
+        List<T> list;
+        list.Capacity(Count());
+        ForEach([&](T value) { list.Add(value); });
+        return list;
+    }
+
+private:
+    List<uint64_t> words;
+    List<Block> blocks;
+    List<T> tail;
+
+    //Packs the full tail into a block - as deltas if it is non-decreasing and that is narrower
+    void Seal() {
+        const T min = *std::min_element(tail.begin(), tail.end());
+        const T max = *std::max_element(tail.begin(), tail.end());
+        const bool sorted = std::is_sorted(tail.begin(), tail.end());
+
+        uint64_t values[blockSize];
+        uint64_t maxDelta = 0;
+        if (sorted) {
+            values[0] = 0;
+            for (size_t j = 1; j < blockSize; j++) {
+                values[j] = uint64_t(tail[j] - tail[j - 1]);
+                maxDelta = std::max(maxDelta, values[j]);
+            }
+        }
+
+        const unsigned offsetBits = bit_detail::BitWidth(uint64_t(max - min));
+        const unsigned deltaBits = bit_detail::BitWidth(maxDelta);
+        const bool delta = sorted && deltaBits < offsetBits;
+        if (!delta) {
+            for (size_t j = 0; j < blockSize; j++) values[j] = uint64_t(tail[j] - min);
+        }
+
+        const unsigned bits = delta ? deltaBits : offsetBits;
+        blocks.Add(Block{ min, max, words.Count(), uint8_t(bits), delta });
+        packed_detail::Pack(values, bits, words);
+        tail.Clear();
+    }
+};
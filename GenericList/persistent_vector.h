@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "list.h"
+
+//Immutable vector with structural sharing: a 32-way radix tree of leaves plus a tail leaf (Clojure style).
+//Add, Set and Slice return a new version in O(log32 n), copying only the path to the changed leaf -
+//every other node is shared with the previous version, so keeping a snapshot per epoch costs O(changes), not O(n).
+//Nodes are never modified once published, so versions can be read from any thread.
+//RemoveAt is O(log32 n) at either end (Slice), but rebuilds the suffix after a removal in the middle.
+//Slice keeps the whole tree of the original alive, like a view - Transient().ToList() makes a compact copy.
+//Transient() returns a Builder that mutates nodes it created itself in place, for batches of edits.
+template <typename T>
+class PersistentVector {
+    static constexpr unsigned bits = 5;
+    static constexpr size_t width = size_t(1) << bits;
+    static constexpr size_t mask = width - 1;
+
+    struct Node;
+    using NodePtr = std::shared_ptr<Node>;
+
+    struct Node {
+        uint64_t owner = 0; //Builder allowed to modify this node in place, 0 if published
+        List<NodePtr> children;
+        List<T> values; //leaves only
+    };
+
+    //Elements are the absolute indices [start, end) - start only moves on Slice
+    struct State {
+        NodePtr root;
+        NodePtr tail = std::make_shared<Node>();
+        unsigned shift = bits;
+        size_t start = 0;
+        size_t end = 0;
+    };
+
+public:
+    class Builder;
+
+    PersistentVector() {
+
+    }
+
+    explicit PersistentVector(const List<T>& list) {
+        Builder builder;
+        for (const auto& e : list) builder.Add(e);
+        state = builder.Persistent().state;
+    }
+
+
+    size_t Count() const { return state.end - state.start; }
+    bool IsEmpty() const { return Count() == 0; }
+
+    const T& operator[](size_t index) const { return At(state, state.start + index); }
+    const T& Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    PersistentVector Add(const T& value) const {
+        PersistentVector result(*this);
+        Append(result.state, value, 0);
+        return result;
+    }
+
+    PersistentVector Set(size_t index, const T& value) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot set element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        PersistentVector result(*this);
+        Assign(result.state, state.start + index, value, 0);
+        return result;
+    }
+
+    //Elements [offset, offset + len) - len is clamped to the end
+    PersistentVector Slice(size_t offset, size_t len) const {
+        if (offset > Count()) throw std::out_of_range(std::string("Cannot slice at out_of_range offset: ") + std::to_string(offset) + std::string("."));
+
+        len = std::min(len, Count() - offset);
+        if (len == 0) return PersistentVector();
+
+        PersistentVector result(*this);
+        result.state.start += offset;
+        Truncate(result.state, result.state.start + len);
+        return result;
+    }
+    PersistentVector Slice(size_t offset) const { return Slice(offset, Count()); }
+
+    PersistentVector RemoveAt(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        if (index == 0) return Slice(1);
+        if (index + 1 == Count()) return Slice(0, index);
+
+        Builder builder(Slice(0, index));
+        ForEachRange(state, state.start + index + 1, state.end, [&](const T& e) { builder.Add(e); });
+        return builder.Persistent();
+    }
+
+    Builder Transient() const { return Builder(*this); }
+
+    //Calls func(element) in order, a leaf at a time
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        ForEachRange(state, state.start, state.end, func);
+    }
+
+    List<T> ToList() const {
+        List<T> list;
+        list.Capacity(Count());
+        ForEachLeaf(state, state.start, state.end, [&](const T* first, const T* last) { list.AddRange(first, last); });
+        return list;
+    }
+
+
+    //Mutable version: nodes created by this builder are modified in place, shared ones are copied once and then owned.
+    //Persistent() publishes the current version - later edits copy again, so published versions never change.
+    class Builder {
+    public:
+        Builder() : owner(NextOwner()) {}
+        explicit Builder(const PersistentVector& vector) : state(vector.state), owner(NextOwner()) {}
+
+        //a copy would share the owner token - and with it the right to modify the same nodes
+        Builder(const Builder&) = delete;
+        Builder& operator=(const Builder&) = delete;
+        Builder(Builder&&) = default;
+        Builder& operator=(Builder&&) = default;
+
+        size_t Count() const { return state.end - state.start; }
+        bool IsEmpty() const { return Count() == 0; }
+
+        const T& operator[](size_t index) const { return At(state, state.start + index); }
+        const T& Get(size_t index) const {
+            if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+            return (*this)[index];
+        }
+
+        void Add(const T& value) {
+            Append(state, value, owner);
+        }
+
+        void Set(size_t index, const T& value) {
+            if (index >= Count()) throw std::out_of_range(std::string("Cannot set element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+            Assign(state, state.start + index, value, owner);
+        }
+
+        PersistentVector Persistent() {
+            owner = NextOwner();
+            PersistentVector result;
+            result.state = state;
+            return result;
+        }
+
+        List<T> ToList() const {
+            List<T> list;
+            list.Capacity(Count());
+            ForEachLeaf(state, state.start, state.end, [&](const T* first, const T* last) { list.AddRange(first, last); });
+            return list;
+        }
+
+    private:
+        State state;
+        uint64_t owner;
+
+        static uint64_t NextOwner() {
+            static std::atomic<uint64_t> next(1);
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+private:
+    State state;
+
+    //First absolute index held by the tail
+    static size_t TailOffset(size_t end) {
+        return end < width ? 0 : ((end - 1) >> bits) << bits;
+    }
+
+    //node itself if owner may modify it, otherwise a copy owned by owner
+    static NodePtr Editable(const NodePtr& node, uint64_t owner) {
+        if (owner != 0 && node->owner == owner) return node;
+        auto copy = std::make_shared<Node>(*node);
+        copy->owner = owner;
+        return copy;
+    }
+
+    static const Node* LeafFor(const State& s, size_t index) {
+        const Node* node = s.root.get();
+        for (unsigned level = s.shift; level > 0; level -= bits) {
+            node = node->children[(index >> level) & mask].get();
+        }
+        return node;
+    }
+
+    static const T& At(const State& s, size_t index) {
+        const size_t tailOffset = TailOffset(s.end);
+        if (index >= tailOffset) return s.tail->values[index - tailOffset];
+        return LeafFor(s, index)->values[index & mask];
+    }
+
+    //Chain of single-child nodes from level down to leaf
+    static NodePtr NewPath(unsigned level, const NodePtr& leaf, uint64_t owner) {
+        if (level == 0) return leaf;
+        auto node = std::make_shared<Node>();
+        node->owner = owner;
+        node->children.Add(NewPath(level - bits, leaf, owner));
+        return node;
+    }
+
+    static NodePtr PushLeaf(unsigned level, const NodePtr& node, size_t index, const NodePtr& leaf, uint64_t owner) {
+        auto result = Editable(node, owner);
+        const size_t sub = (index >> level) & mask;
+        NodePtr child;
+        if (level == bits) child = leaf;
+        else if (sub < result->children.Count()) child = PushLeaf(level - bits, result->children[sub], index, leaf, owner);
+        else child = NewPath(level - bits, leaf, owner);
+
+        //after a Slice the tree may still hold the old leaves past the tail - they are replaced
+        if (sub < result->children.Count()) result->children[sub] = std::move(child);
+        else result->children.Add(std::move(child));
+        return result;
+    }
+
+    static void Append(State& s, const T& value, uint64_t owner) {
+        if (s.end - TailOffset(s.end) < width) {
+            s.tail = Editable(s.tail, owner);
+            s.tail->values.Add(value);
+            ++s.end;
+            return;
+        }
+
+        //full tail moves into the tree - the root grows a level once every leaf slot under it is taken
+        const size_t tailOffset = s.end - width;
+        if (s.root == nullptr) {
+            s.root = std::make_shared<Node>();
+            s.root->owner = owner;
+            s.shift = bits;
+        }
+        if ((tailOffset >> bits) >= (size_t(1) << s.shift)) {
+            auto root = std::make_shared<Node>();
+            root->owner = owner;
+            root->children.Add(s.root);
+            root->children.Add(NewPath(s.shift, s.tail, owner));
+            s.root = std::move(root);
+            s.shift += bits;
+        }
+        else {
+            s.root = PushLeaf(s.shift, s.root, tailOffset, s.tail, owner);
+        }
+
+        s.tail = std::make_shared<Node>();
+        s.tail->owner = owner;
+        s.tail->values.Add(value);
+        ++s.end;
+    }
+
+    static NodePtr AssignAt(unsigned level, const NodePtr& node, size_t index, const T& value, uint64_t owner) {
+        auto result = Editable(node, owner);
+        if (level == 0) result->values[index & mask] = value;
+        else {
+            const size_t sub = (index >> level) & mask;
+            result->children[sub] = AssignAt(level - bits, result->children[sub], index, value, owner);
+        }
+        return result;
+    }
+
+    static void Assign(State& s, size_t index, const T& value, uint64_t owner) {
+        const size_t tailOffset = TailOffset(s.end);
+        if (index >= tailOffset) {
+            s.tail = Editable(s.tail, owner);
+            s.tail->values[index - tailOffset] = value;
+        }
+        else {
+            s.root = AssignAt(s.shift, s.root, index, value, owner);
+        }
+    }
+
+    //Drops the elements from end onwards - the tail becomes a copy of the leaf holding the new last element
+    static void Truncate(State& s, size_t end) {
+        const size_t tailOffset = TailOffset(end);
+        const Node* leaf = tailOffset == TailOffset(s.end) ? s.tail.get() : LeafFor(s, tailOffset);
+
+        auto tail = std::make_shared<Node>();
+        tail->values.AddRange(leaf->values.begin(), leaf->values.begin() + (end - tailOffset));
+        s.tail = std::move(tail);
+        s.end = end;
+    }
+
+    //Calls func(first, last) for every contiguous run of elements in the absolute range [first, last)
+    template <typename Func>
+    static void ForEachLeaf(const State& s, size_t first, size_t last, Func&& func) {
+        const size_t tailOffset = TailOffset(s.end);
+        while (first < last) {
+            const Node* leaf = first >= tailOffset ? s.tail.get() : LeafFor(s, first);
+            const size_t leafStart = first >= tailOffset ? tailOffset : first & ~mask;
+            const size_t leafEnd = std::min(last, leafStart + leaf->values.Count());
+            func(leaf->values.begin() + (first - leafStart), leaf->values.begin() + (leafEnd - leafStart));
+            first = leafEnd;
+        }
+    }
+
+    template <typename Func>
+    static void ForEachRange(const State& s, size_t first, size_t last, Func&& func) {
+        ForEachLeaf(s, first, last, [&](const T* begin, const T* end) {
+            for (auto ptr = begin; ptr < end; ++ptr) func(*ptr);
+        });
+    }
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "list.h"
+#include "list_view.h"
+
+//List<std::string> with a sorted permutation index (element indices ordered by value, ties by index) kept in sync
+//on Add/Remove, for "all elements starting with X" queries without a full FindIf scan.
+//FindPrefix and CountPrefix binary search the permutation: O(|prefix| log n) to find the range, plus the matches.
+//Add and RemoveAt keep the permutation sorted by shifting it (a memmove of indices, no string compares beyond the search).
+//Removal (RemoveAt, Remove, RemoveIfPrefix) is O(n), not O(|prefix| + matches): element indices stay dense like List's, so
+//the elements are compacted and every index in the permutation is renumbered in one pass. Batch removals through
+//Remove/RemoveIfPrefix rather than RemoveAt in a loop - each call pays the renumbering once.
+//Elements are read-only through the index - mutating one in place would silently break the order.
+class PrefixIndexedList {
+public:
+    static constexpr size_t npos = size_t(-1);
+
+    PrefixIndexedList() {
+
+    }
+
+    explicit PrefixIndexedList(List<std::string> elements) : elements(std::move(elements)) {
+        Rebuild();
+    }
+
+
+    size_t Count() const { return elements.Count(); }
+    bool IsEmpty() const { return elements.Count() == 0; }
+
+    const std::string& operator[](size_t index) const { return elements[index]; }
+    const std::string& Get(size_t index) const { return elements.Get(index); }
+
+    const std::string* begin() const { return elements.begin(); }
+    const std::string* end() const { return elements.end(); }
+
+    ListView<std::string> View() const { return ListView<std::string>(elements); }
+
+    //Element indices in lexicographic order of their values
+    ListView<size_t> Sorted() const { return ListView<size_t>(sorted); }
+
+    void Clear() {
+        elements.Clear();
+        sorted.Clear();
+    }
+
+    void Add(std::string value) {
+        //upper bound - equal values stay ordered by index, so the first of an equal run is the lowest index
+        const size_t position = size_t(std::upper_bound(sorted.begin(), sorted.end(), std::string_view(value), [&](std::string_view v, size_t index) { return v < std::string_view(elements[index]); }) - sorted.begin());
+        elements.Add(std::move(value));
+        sorted.Add(elements.Count() - 1);
+        std::rotate(sorted.begin() + position, sorted.end() - 1, sorted.end());
+    }
+
+    //Index of the first element equal to val, npos if none
+    size_t Find(std::string_view val) const {
+        const size_t first = LowerBound(val);
+        return first < sorted.Count() && elements[sorted[first]] == val ? sorted[first] : npos;
+    }
+
+    bool Contains(std::string_view val) const {
+        return Find(val) != npos;
+    }
+
+    //Indices of the elements starting with prefix, in lexicographic order of the elements
+    List<size_t> FindPrefix(std::string_view prefix) const {
+        List<size_t> indices;
+        const size_t first = LowerBound(prefix);
+        const size_t last = PrefixEnd(first, prefix);
+        indices.AddRange(sorted.begin() + first, sorted.begin() + last);
+        return indices;
+    }
+
+    size_t CountPrefix(std::string_view prefix) const {
+        const size_t first = LowerBound(prefix);
+        return PrefixEnd(first, prefix) - first;
+    }
+
+    void RemoveAt(size_t index) {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        //equal values are ordered by index, so the element's slot is found by a second search inside its equal run
+        const std::string_view val = elements[index];
+        const size_t first = LowerBound(val);
+        const size_t position = size_t(std::lower_bound(sorted.begin() + first, sorted.end(), index, [&](size_t e, size_t i) { return elements[e] == val && e < i; }) - sorted.begin());
+
+        sorted.RemoveRange(position, position + 1);
+        for (auto& e : sorted) {
+            if (e > index) --e;
+        }
+        elements.RemoveAt(index);
+    }
+
+    //Removes every element equal to val, returns how many were removed
+    size_t Remove(std::string_view val) {
+        const size_t first = LowerBound(val);
+        size_t last = first;
+        while (last < sorted.Count() && elements[sorted[last]] == val) ++last;
+        return RemoveSortedRange(first, last);
+    }
+
+    //Removes every element starting with prefix, returns how many were removed
+    size_t RemoveIfPrefix(std::string_view prefix) {
+        const size_t first = LowerBound(prefix);
+        return RemoveSortedRange(first, PrefixEnd(first, prefix));
+    }
+
+    //Hands the elements back (the index is left empty)
+    List<std::string> Release() {
+        sorted.Clear();
+        return std::move(elements);
+    }
+
+private:
+    List<std::string> elements;
+    List<size_t> sorted;
+
+    void Rebuild() {
+        sorted.Clear();
+        sorted.Capacity(elements.Count());
+        for (size_t i = 0; i < elements.Count(); i++) sorted.Add(i);
+        sorted.StableSort([&](size_t a, size_t b) { return elements[a] < elements[b]; });
+    }
+
+    //First position in sorted whose element is not less than key
+    size_t LowerBound(std::string_view key) const {
+        return size_t(std::lower_bound(sorted.begin(), sorted.end(), key, [&](size_t index, std::string_view k) { return std::string_view(elements[index]) < k; }) - sorted.begin());
+    }
+
+    //End of the run of elements starting with prefix, given its first position
+    size_t PrefixEnd(size_t first, std::string_view prefix) const {
+        return size_t(std::partition_point(sorted.begin() + first, sorted.end(), [&](size_t index) { return std::string_view(elements[index]).substr(0, prefix.size()) == prefix; }) - sorted.begin());
+    }
+
+    //Removes the elements at sorted[first, last) from both the elements and the permutation
+    size_t RemoveSortedRange(size_t first, size_t last) {
+        const size_t removed = last - first;
+        if (removed == 0) return 0;
+
+        //new index of every element = old index - removed elements before it
+        List<size_t> shift;
+        shift.Capacity(elements.Count() + 1);
+        for (size_t i = 0; i <= elements.Count(); i++) shift.Add(0);
+        for (size_t i = first; i < last; i++) shift[sorted[i] + 1] = 1;
+        for (size_t i = 1; i <= elements.Count(); i++) shift[i] += shift[i - 1];
+
+        elements.RemoveAtMany(ListView<size_t>(sorted).Slice(first, removed));
+        sorted.RemoveRange(first, last);
+        for (auto& e : sorted) e -= shift[e];
+        return removed;
+    }
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "list.h"
+#include "list_view.h"
+
+//List for one writer and many concurrent readers, without a reader-writer lock.
+//Readers take a Snapshot: a pointer to the current buffer and its published count, read lock-free and never torn.
+//Add constructs the element past the published count and then publishes it, so readers never see it half-built;
+//growing the buffer or RemoveIf/Clear build a new buffer and swap it in. Replaced buffers are retired with the current
+//epoch and freed once no reader registered at that epoch or earlier is still active (epoch-based reclamation).
+//Readers register in one of maxReaders slots - beyond that many simultaneous snapshots, Read() yields until one is released.
+//Writer methods must not be called concurrently with each other.
+template <typename T>
+class RcuList {
+    struct Buffer {
+        List<T> items; //never grows past its capacity, so the element storage never moves
+        std::atomic<size_t> published;
+
+        explicit Buffer(size_t capacity) : published(0) {
+            items.Capacity(capacity);
+        }
+    };
+
+    struct Retired {
+        Buffer* buffer;
+        uint64_t epoch;
+    };
+
+public:
+    static constexpr size_t maxReaders = 64;
+
+    //Read-only view of the list as it was when Read() was called - the buffer stays alive until the snapshot is destroyed
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept : owner(other.owner), slot(other.slot), view(other.view) {
+            other.owner = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        ~Snapshot() {
+            if (owner != nullptr) owner->readers[slot].store(0, std::memory_order_release);
+        }
+
+        size_t Count() const { return view.Count(); }
+        bool IsEmpty() const { return view.Count() == 0; }
+
+        const T& operator[](size_t index) const { return view[index]; }
+        const T& Get(size_t index) const { return view.Get(index); }
+
+        const T* Find(const T& val) const { return view.Find(val); }
+        template <typename Predicate>
+        const T* FindIf(Predicate&& pred) const { return view.FindIf(std::forward<Predicate>(pred)); }
+
+        const T* begin() const { return view.begin(); }
+        const T* end() const { return view.end(); }
+
+        ListView<T> View() const { return view; }
+
+    private:
+        friend class RcuList;
+        Snapshot(const RcuList* owner, size_t slot, ListView<T> view) : owner(owner), slot(slot), view(view) {}
+
+        const RcuList* owner;
+        size_t slot;
+        ListView<T> view;
+    };
+
+    RcuList() : current(new Buffer(0)), epoch(1) {
+        for (auto& reader : readers) reader.store(0, std::memory_order_relaxed);
+    }
+
+    //No snapshot may outlive the list
+    ~RcuList() {
+        for (const auto& retired : retiredBuffers) delete retired.buffer;
+        delete current.load(std::memory_order_relaxed);
+    }
+
+    RcuList(const RcuList&) = delete;
+    RcuList& operator=(const RcuList&) = delete;
+
+
+    //Reader side - safe from any thread, concurrently with the writer
+    Snapshot Read() const {
+        const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % maxReaders;
+        for (size_t attempt = 0;; attempt++) {
+            const size_t slot = (start + attempt) % maxReaders;
+            uint64_t expected = 0;
+            //the slot must hold an epoch no later than the one the buffer is loaded under
+            if (readers[slot].compare_exchange_strong(expected, epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst)) {
+                const Buffer* buffer = current.load(std::memory_order_seq_cst);
+                const size_t count = buffer->published.load(std::memory_order_acquire);
+                return Snapshot(this, slot, ListView<T>(buffer->items.begin(), count));
+            }
+            if (attempt % maxReaders == maxReaders - 1) std::this_thread::yield();
+        }
+    }
+
+
+    //Writer side
+    size_t Count() const { return current.load(std::memory_order_relaxed)->published.load(std::memory_order_relaxed); }
+    //Replaced buffers not freed yet (a reader may still be using them)
+    size_t RetiredCount() const { return retiredBuffers.Count(); }
+
+    void Add(const T& value) {
+        Buffer* buffer = current.load(std::memory_order_relaxed);
+        const size_t count = buffer->published.load(std::memory_order_relaxed);
+        if (count == buffer->items.Capacity()) {
+            //grow: copy into a larger buffer, readers keep using the old one until they take a new snapshot
+            Buffer* grown = new Buffer(count == 0 ? 4 : count * 2);
+            grown->items.AddRange(buffer->items.begin(), buffer->items.end());
+            grown->published.store(count, std::memory_order_relaxed);
+            Publish(grown);
+            buffer = grown;
+        }
+
+        buffer->items.Add(value);
+        buffer->published.store(count + 1, std::memory_order_release);
+    }
+
+    //Survivors are copied into a new buffer, which replaces the old one in a single step
+    template <typename Predicate>
+    size_t RemoveIf(Predicate&& pred) {
+        Buffer* buffer = current.load(std::memory_order_relaxed);
+        const T* found = buffer->items.FindIf(pred);
+        if (found == nullptr) return 0;
+
+        //pred runs once per element: everything before the first match is kept without asking again
+        Buffer* kept = new Buffer(buffer->items.Capacity());
+        kept->items.AddRange(buffer->items.begin(), found);
+        for (auto ptr = found + 1; ptr < buffer->items.end(); ++ptr) {
+            if (!pred(*ptr)) kept->items.Add(*ptr);
+        }
+        const size_t removed = buffer->items.Count() - kept->items.Count();
+        kept->published.store(kept->items.Count(), std::memory_order_relaxed);
+        Publish(kept);
+        return removed;
+    }
+
+    size_t Remove(const T& val) {
+        return RemoveIf([&](const T& e) { return e == val; });
+    }
+
+    void Clear() {
+        Publish(new Buffer(0));
+    }
+
+    //Frees the retired buffers no active reader can still see
+    void Reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        for (const auto& reader : readers) {
+            const uint64_t readerEpoch = reader.load(std::memory_order_seq_cst);
+            if (readerEpoch != 0 && readerEpoch < oldest) oldest = readerEpoch;
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < retiredBuffers.Count(); i++) {
+            if (retiredBuffers[i].epoch < oldest) delete retiredBuffers[i].buffer;
+            else retiredBuffers[kept++] = retiredBuffers[i];
+        }
+        retiredBuffers.RemoveRange(kept, retiredBuffers.Count());
+    }
+
+private:
+    std::atomic<Buffer*> current;
+    std::atomic<uint64_t> epoch;
+    mutable std::atomic<uint64_t> readers[maxReaders]; //epoch each active reader registered at, 0 if the slot is free
+    List<Retired> retiredBuffers;
+
+    //Swaps in buffer, retires the old one under the current epoch and starts a new epoch
+    void Publish(Buffer* buffer) {
+        Buffer* old = current.exchange(buffer, std::memory_order_seq_cst);
+        retiredBuffers.Add(Retired{ old, epoch.fetch_add(1, std::memory_order_seq_cst) });
+        Reclaim();
+    }
+};
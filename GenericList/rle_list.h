@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "list.h"
+#include "list_view.h"
+
+//Run-length encoded List for long runs of identical values (status codes, partition ids, ...):
+//one value per run plus the running end index of each run, so Get binary searches the runs (O(log runs)) and
+//Find, Count(val) and RemoveIf touch each run once instead of each element.
+template <typename T>
+class RleList {
+public:
+    static constexpr size_t npos = size_t(-1);
+
+    RleList() {
+
+    }
+
+    explicit RleList(ListView<T> view) {
+        for (const auto& e : view) Add(e);
+    }
+
+
+    size_t Count() const { return ends.Count() == 0 ? 0 : ends[ends.Count() - 1]; }
+    bool IsEmpty() const { return ends.Count() == 0; }
+    size_t RunCount() const { return values.Count(); }
+
+    void Clear() {
+        values.Clear();
+        ends.Clear();
+    }
+
+    //Extends the last run if value equals it, otherwise starts a new one
+    void Add(const T& value) {
+        AddRun(value, 1);
+    }
+
+    void Add(const T& value, size_t repeat) {
+        if (repeat != 0) AddRun(value, repeat);
+    }
+
+    const T& operator[](size_t index) const { return values[RunOf(index)]; }
+    const T& Get(size_t index) const {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot get element at out_of_range index: ") + std::to_string(index) + std::string(")"));
+
+        return (*this)[index];
+    }
+
+    //Index of the first element equal to val, npos if none
+    size_t Find(const T& val) const {
+        for (size_t run = 0; run < values.Count(); run++) {
+            if (values[run] == val) return RunStart(run);
+        }
+        return npos;
+    }
+
+    template <typename Predicate>
+    size_t FindIf(Predicate&& pred) const {
+        for (size_t run = 0; run < values.Count(); run++) {
+            if (pred(values[run])) return RunStart(run);
+        }
+        return npos;
+    }
+
+    bool Contains(const T& val) const {
+        return Find(val) != npos;
+    }
+
+    size_t Count(const T& val) const {
+        size_t n = 0;
+        for (size_t run = 0; run < values.Count(); run++) {
+            if (values[run] == val) n += ends[run] - RunStart(run);
+        }
+        return n;
+    }
+
+    void RemoveAt(size_t index) {
+        if (index >= Count()) throw std::out_of_range(std::string("Cannot remove element at out_of_range index: ") + std::to_string(index) + std::string("."));
+
+        const size_t run = RunOf(index);
+        for (size_t i = run; i < ends.Count(); i++) --ends[i];
+        //an emptied run is dropped, and its neighbours merged if equal
+        if (ends[run] == RunStart(run)) RemoveRuns([](size_t) { return false; });
+    }
+
+    size_t Remove(const T& val) {
+        return RemoveIf([&](const T& e) { return e == val; });
+    }
+
+    //pred runs once per run - neighbours of removed runs are merged if equal
+    template <typename Predicate>
+    size_t RemoveIf(Predicate&& pred) {
+        const size_t before = Count();
+        RemoveRuns([&](size_t run) { return bool(pred(values[run])); });
+        return before - Count();
+    }
+
+    //Calls func(value, length) for every run in order
+    template <typename Func>
+    void ForEachRun(Func&& func) const {
+        for (size_t run = 0; run < values.Count(); run++) func(values[run], ends[run] - RunStart(run));
+    }
+
+    List<T> ToList() const {
+        List<T> list;
+        list.Capacity(Count());
+        ForEachRun([&](const T& value, size_t length) {
+            for (size_t i = 0; i < length; i++) list.Add(value);
+        });
+        return list;
+    }
+
+private:
+    List<T> values;
+    List<size_t> ends; //ends[run] = index one past the run's last element
+
+    size_t RunStart(size_t run) const { return run == 0 ? 0 : ends[run - 1]; }
+
+    //Run holding element index (index < Count())
+    size_t RunOf(size_t index) const {
+        return size_t(std::upper_bound(ends.begin(), ends.end(), index) - ends.begin());
+    }
+
+    void AddRun(const T& value, size_t length) {
+        if (values.Count() != 0 && values[values.Count() - 1] == value) {
+            ends[ends.Count() - 1] += length;
+            return;
+        }
+        values.Add(value);
+        ends.Add(Count() + length);
+    }
+
+    //Rebuilds the runs without the removed ones (and without empty ones), merging runs that become adjacent
+    template <typename RunPredicate>
+    void RemoveRuns(RunPredicate&& removed) {
+        size_t kept = 0;
+        size_t end = 0;
+        size_t oldEnd = 0; //ends[] is overwritten while compacting - keep the original end of the previous run
+        for (size_t run = 0; run < values.Count(); run++) {
+            const size_t length = ends[run] - oldEnd;
+            oldEnd = ends[run];
+            if (length == 0 || removed(run)) continue;
+
+            end += length;
+            if (kept != 0 && values[kept - 1] == values[run]) {
+                ends[kept - 1] = end;
+                continue;
+            }
+            if (kept != run) values[kept] = std::move(values[run]);
+            ends[kept] = end;
+            ++kept;
+        }
+        values.RemoveRange(kept, values.Count());
+        ends.RemoveRange(kept, ends.Count());
+    }
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define STRING_SEARCH_SSE2 1
+#include <emmintrin.h>
+#else
+#define STRING_SEARCH_SSE2 0
+#endif
+
+#include "list.h"
+#include "list_view.h"
+#include "list_pipeline.h"
+#include "bit_list.h"
+
+//Substring search compiled once per needle, then run against every element of a string List:
+//FindContaining (indices), MatchContaining (BitList mask), CountContaining, RemoveIfContains, RemoveIfNotContains.
+//Short needles use a SIMD first/last byte filter (16 candidate positions per step, memcmp only where both bytes match),
+//long needles use the Two-Way algorithm (linear worst case, no per-needle tables beyond two integers).
+class SubstringSearcher {
+public:
+    //Needles at least this long use Two-Way
+    static constexpr size_t twoWayThreshold = 64;
+
+    //needle is copied - the searcher doesn't depend on the caller's buffer
+    explicit SubstringSearcher(std::string_view needle) : needle(needle), critical(0), period(0), periodic(false) {
+        if (this->needle.size() >= twoWayThreshold) Factorize();
+    }
+
+    bool Contains(std::string_view haystack) const {
+        return Find(haystack) != std::string_view::npos;
+    }
+
+    //Position of the first occurrence of the needle in haystack, npos if none
+    size_t Find(std::string_view haystack) const {
+        const size_t m = needle.size();
+        if (m == 0) return 0;
+        if (haystack.size() < m) return std::string_view::npos;
+        if (m == 1) {
+            const void* found = std::memchr(haystack.data(), needle[0], haystack.size());
+            return found != nullptr ? size_t(static_cast<const char*>(found) - haystack.data()) : std::string_view::npos;
+        }
+        if (m >= twoWayThreshold) return FindTwoWay(haystack);
+        return FindFiltered(haystack);
+    }
+
+    std::string_view Needle() const { return needle; }
+
+private:
+    std::string needle;
+    ptrdiff_t critical; //Two-Way critical factorization position (last index of the left half, may be -1)
+    size_t period;
+    bool periodic;
+
+    //Candidates: positions whose first and last bytes match the needle's - checked 16 at a time, then confirmed with memcmp
+    size_t FindFiltered(std::string_view haystack) const {
+        const size_t m = needle.size();
+        const size_t last = haystack.size() - m; //last valid start position
+        const char* text = haystack.data();
+        size_t pos = 0;
+
+#if STRING_SEARCH_SSE2
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i lastByte = _mm_set1_epi8(needle[m - 1]);
+        for (; pos + 16 <= last + 1; pos += 16) {
+            const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos));
+            const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos + m - 1));
+            unsigned mask = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, lastByte))));
+            while (mask != 0) {
+                const size_t bit = bit_detail::CountTrailingZeros(mask);
+                if (std::memcmp(text + pos + bit + 1, needle.data() + 1, m - 2) == 0) return pos + bit;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; pos <= last; ++pos) {
+            if (text[pos] == needle[0] && text[pos + m - 1] == needle[m - 1] && std::memcmp(text + pos + 1, needle.data() + 1, m - 2) == 0) return pos;
+        }
+        return std::string_view::npos;
+    }
+
+    //Start of the maximal suffix of the needle for the (reversed) byte order, and its period
+    void MaximalSuffix(bool reversed, ptrdiff_t& suffix, size_t& suffixPeriod) const {
+        const ptrdiff_t m = ptrdiff_t(needle.size());
+        const unsigned char* x = reinterpret_cast<const unsigned char*>(needle.data());
+        ptrdiff_t ms = -1, j = 0, k = 1, p = 1;
+        while (j + k < m) {
+            const unsigned char a = x[j + k];
+            const unsigned char b = x[ms + k];
+            if (reversed ? a > b : a < b) {
+                j += k;
+                k = 1;
+                p = j - ms;
+            }
+            else if (a == b) {
+                if (k != p) ++k;
+                else {
+                    j += p;
+                    k = 1;
+                }
+            }
+            else {
+                ms = j++;
+                k = p = 1;
+            }
+        }
+        suffix = ms;
+        suffixPeriod = size_t(p);
+    }
+
+    //Critical factorization: the later of the two maximal suffixes splits the needle so that its local period equals the global one
+    void Factorize() {
+        ptrdiff_t suffix, reversedSuffix;
+        size_t suffixPeriod, reversedPeriod;
+        MaximalSuffix(false, suffix, suffixPeriod);
+        MaximalSuffix(true, reversedSuffix, reversedPeriod);
+
+        if (suffix > reversedSuffix) {
+            critical = suffix;
+            period = suffixPeriod;
+        }
+        else {
+            critical = reversedSuffix;
+            period = reversedPeriod;
+        }
+
+        //the needle is periodic if its left half repeats period bytes later - then matched prefixes can be remembered between shifts
+        const size_t m = needle.size();
+        periodic = std::memcmp(needle.data(), needle.data() + period, size_t(critical + 1)) == 0;
+        if (!periodic) period = std::max(size_t(critical + 1), m - size_t(critical + 1)) + 1;
+    }
+
+    size_t FindTwoWay(std::string_view haystack) const {
+        const ptrdiff_t m = ptrdiff_t(needle.size());
+        const ptrdiff_t n = ptrdiff_t(haystack.size());
+        const char* x = needle.data();
+        const char* y = haystack.data();
+        const ptrdiff_t per = ptrdiff_t(period);
+
+        ptrdiff_t j = 0;
+        ptrdiff_t memory = -1; //prefix of the needle known to match at the current shift (periodic needles only)
+        while (j <= n - m) {
+            //right half, left to right
+            ptrdiff_t i = std::max(critical, memory) + 1;
+            while (i < m && x[i] == y[i + j]) ++i;
+            if (i < m) {
+                j += i - critical;
+                memory = -1;
+                continue;
+            }
+
+            //left half, right to left
+            i = critical;
+            while (i > memory && x[i] == y[i + j]) --i;
+            if (i <= memory) return size_t(j);
+
+            j += per;
+            memory = periodic ? m - per - 1 : -1;
+        }
+        return std::string_view::npos;
+    }
+};
+
+
+namespace search_detail {
+    //Indices (in increasing order) of the elements of view containing the searcher's needle
+    template <typename String>
+    List<size_t> MatchingIndices(ListView<String> view, const SubstringSearcher& searcher, LazyExecution execution) {
+        const String* base = view.begin();
+        auto kernel = [&](const String* first, const String* last) {
+            List<size_t> indices;
+            for (auto ptr = first; ptr < last; ++ptr) {
+                if (searcher.Contains(*ptr)) indices.Add(size_t(ptr - base));
+            }
+            return indices;
+        };
+
+        const size_t chunks = lazy_detail::ChunkCount(execution, view.Count());
+        if (chunks <= 1) return kernel(view.begin(), view.end());
+
+        List<List<size_t>> results;
+        lazy_detail::RunChunks(view.begin(), view.end(), chunks, results, kernel);
+
+        List<size_t> indices;
+        for (const auto& result : results) {
+            indices.AddRange(result.begin(), result.end());
+        }
+        return indices;
+    }
+
+    inline BitList IndicesToMask(const List<size_t>& indices, size_t count) {
+        BitList mask(count, false);
+        for (size_t index : indices) mask.Set(index, true);
+        return mask;
+    }
+}
+
+
+//Indices of the elements containing needle
+template <typename String>
+List<size_t> FindContaining(ListView<String> view, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) {
+    return search_detail::MatchingIndices(view, SubstringSearcher(needle), execution);
+}
+
+//Mask with flag i set if element i contains needle (feeds List::RemoveByMask)
+template <typename String>
+BitList MatchContaining(ListView<String> view, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) {
+    return search_detail::IndicesToMask(FindContaining(view, needle, execution), view.Count());
+}
+
+template <typename String>
+size_t CountContaining(ListView<String> view, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) {
+    return FindContaining(view, needle, execution).Count();
+}
+
+template <typename String, typename Allocator>
+List<size_t> FindContaining(const List<String, Allocator>& list, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) { return FindContaining(ListView<String>(list), needle, execution); }
+template <typename String, typename Allocator>
+BitList MatchContaining(const List<String, Allocator>& list, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) { return MatchContaining(ListView<String>(list), needle, execution); }
+template <typename String, typename Allocator>
+size_t CountContaining(const List<String, Allocator>& list, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) { return CountContaining(ListView<String>(list), needle, execution); }
+
+//Removes the elements containing needle - the search runs (optionally in parallel) before a single compaction pass
+template <typename String, typename Allocator>
+size_t RemoveIfContains(List<String, Allocator>& list, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) {
+    return list.RemoveByMask(MatchContaining(list, needle, execution));
+}
+
+//Removes the elements not containing needle (the demo's RemoveIf(find("[processed]") == npos))
+template <typename String, typename Allocator>
+size_t RemoveIfNotContains(List<String, Allocator>& list, std::string_view needle, LazyExecution execution = LazyExecution::Sequential) {
+    BitList mask = MatchContaining(list, needle, execution);
+    mask.Not();
+    return list.RemoveByMask(mask);
+}
@@ -1,6 +1,25 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "../GenericList/list.h"
+#include "../GenericList/cow_list.h"
+#include "../GenericList/list_view.h"
+#include "../GenericList/list_pipeline.h"
+#include "../GenericList/list_reduce.h"
+#include "../GenericList/list_set.h"
+#include "../GenericList/bit_list.h"
+#include "../GenericList/arena_string_list.h"
+#include "../GenericList/string_search.h"
+#include "../GenericList/prefix_index.h"
+#include "../GenericList/dict_list.h"
+#include "../GenericList/packed_int_list.h"
+#include "../GenericList/rle_list.h"
+#include "../GenericList/compressed_float_list.h"
+#include "../GenericList/persistent_vector.h"
+#include "../GenericList/rcu_list.h"
+#include "../GenericList/list_io.h"
+#include "../GenericList/list_channel.h"
+#include "../GenericList/list_prefetch.h"
+#include "../GenericList/fixed_list.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace std;
@@ -279,6 +298,70 @@ namespace GenericListTest
 		}
 
 
+		TEST_METHOD(FindAll_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 200; i++) list.Add(i % 10);
+
+			List<size_t> indices = list.FindAll([](int e) { return e == 3; });
+			Assert::IsTrue(indices.Count() == 20 && indices[0] == 3 && indices[19] == 193);
+			Assert::IsTrue(list.CountIf([](int e) { return e < 5; }) == 100);
+			Assert::IsTrue(list.FindAll([](int e) { return e > 9; }).Count() == 0);
+
+			//masks cover full words and the partial tail
+			BitList mask = list.MatchMask([](int e) { return e == 3 || e == 7; });
+			Assert::IsTrue(mask.Count() == 200 && mask.CountSet() == 40 && mask[193] && mask[197] && !mask[199]);
+			Assert::IsTrue(list.RemoveByMask(mask) == 40 && list.Count() == 160 && list.CountIf([](int e) { return e == 3; }) == 0);
+		}
+
+		TEST_METHOD(FindAll_ClassTypes) {
+			List<std::string> list;
+			list.Add("GET /");
+			list.Add("POST /login");
+			list.Add("GET /favicon.ico");
+
+			List<size_t> indices = list.FindAll([](const std::string& e) { return e.rfind("GET", 0) == 0; });
+			Assert::IsTrue(indices.Count() == 2 && indices[1] == 2);
+			Assert::IsTrue(list.MatchMask([](const std::string& e) { return e.size() > 5; }).CountSet() == 2);
+			Assert::IsTrue(List<std::string>().MatchMask([](const std::string&) { return true; }).Count() == 0);
+		}
+
+		TEST_METHOD(HeterogeneousLookup_ClassTypes) {
+			List<string> list;
+			string addedElements[] = { "hi", ",", "bob", "a string longer than the small string buffer", "bob" };
+			for (size_t i = 0; i < 5; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			const char* key = "bob";
+			std::string_view view = "a string longer than the small string buffer";
+			Assert::IsTrue(list.Find(key) - list.begin() == 2);
+			Assert::IsTrue(list.Find(view) - list.begin() == 3);
+			Assert::IsTrue(list.Find(std::string_view("bo")) == nullptr); //same prefix, different length
+			Assert::IsTrue(list.Contains("hi") && !list.Contains("by"));
+
+			const List<string>& constList = list;
+			Assert::IsTrue(constList.Find(std::string_view(",")) == list.begin() + 1);
+
+			Assert::IsTrue(list.Remove(std::string_view("bob")) == 2);
+			Assert::IsTrue(list.Count() == 3 && !list.Contains(key));
+			Assert::IsTrue(list.RemoveUnordered(std::string_view("hi")) == 1);
+			Assert::IsTrue(list.Count() == 2 && !list.Contains("hi"));
+		}
+
+		TEST_METHOD(HeterogeneousLookup_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 10; i++) {
+				list.Add(i * 2);
+			}
+
+			Assert::IsTrue(list.Find(4LL) - list.begin() == 2);
+			//arithmetic keys go through the const T& overloads: converted to int first
+			Assert::IsTrue(list.Contains(6.0) && list.Contains(6.5));
+			Assert::IsTrue(list.Find(size_t(18)) == list.end() - 1);
+			Assert::IsTrue(list.Remove(short(8)) == 1);
+			Assert::IsTrue(!list.Contains(8));
+		}
+
 		TEST_METHOD(Remove_FundamentalTypes) {
 			List<int> list;
 
@@ -372,6 +455,223 @@ namespace GenericListTest
 			Assert::IsTrue(list.Count() == 0);
 		}
 
+		TEST_METHOD(RemoveUnordered_FundamentalTypes) {
+			List<int> list;
+
+			size_t addedAmount = 10;
+
+			for (size_t i = 0; i < addedAmount; i++) {
+				list.Add(i * 2);
+			}
+
+			//last element is moved into the hole
+			list.RemoveAtUnordered(2);
+			Assert::IsTrue(list.Count() == addedAmount - 1);
+			Assert::IsTrue(list[2] == int(addedAmount - 1) * 2);
+			Assert::IsTrue(list.Find(4) == nullptr);
+
+			//removing the last element doesn't move anything
+			list.RemoveAtUnordered(list.Count() - 1);
+			Assert::IsTrue(list.Count() == addedAmount - 2);
+
+			Assert::ExpectException<std::out_of_range>([&]() { list.RemoveAtUnordered(list.Count()); });
+
+			Assert::IsFalse(list.RemoveUnordered(addedAmount * 2 + 5) > 0);
+			Assert::IsTrue(list.RemoveUnordered(0) == 1);
+			Assert::IsTrue(list.Find(0) == nullptr);
+		}
+
+		TEST_METHOD(RemoveIfUnordered_FundamentalTypes) {
+			List<int> list;
+
+			size_t addedAmount = 100;
+
+			for (size_t i = 0; i < addedAmount; i++) {
+				list.Add(i);
+			}
+
+			size_t checks = 0;
+			Assert::IsTrue(list.RemoveIfUnordered([&](const auto& e) { ++checks; return e % 3 == 0; }) == 34);
+			Assert::IsTrue(checks == addedAmount); //each element is only checked once
+			Assert::IsTrue(list.Count() == addedAmount - 34);
+
+			//every kept element is still there, exactly once
+			int sum = 0;
+			for (int e : list) {
+				Assert::IsTrue(e % 3 != 0);
+				sum += e;
+			}
+			int expected = 0;
+			for (size_t i = 0; i < addedAmount; i++) {
+				if (i % 3 != 0) expected += int(i);
+			}
+			Assert::IsTrue(sum == expected);
+
+			Assert::IsTrue(list.RemoveIfUnordered([](const auto&) { return true; }) == addedAmount - 34);
+			Assert::IsTrue(list.Count() == 0);
+			Assert::IsTrue(list.RemoveIfUnordered([](const auto&) { return true; }) == 0);
+		}
+
+		TEST_METHOD(RemoveIfUnordered_ClassTypes) {
+			List<string> list;
+
+			string addedElements[] = { "hi", ",", "bob", "hi", "tot" };
+
+			for (size_t i = 0; i < 5; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			Assert::IsTrue(list.RemoveUnordered("by") == 0);
+			Assert::IsTrue(list.RemoveUnordered("hi") == 2);
+			Assert::IsTrue(list.Count() == 3);
+			Assert::IsTrue(list.Find("hi") == nullptr);
+			Assert::IsTrue(list.Find(",") != nullptr);
+			Assert::IsTrue(list.Find("bob") != nullptr);
+			Assert::IsTrue(list.Find("tot") != nullptr);
+		}
+
+		TEST_METHOD(RemoveRange_FundamentalTypes) {
+			List<int> list;
+
+			size_t addedAmount = 10;
+
+			for (size_t i = 0; i < addedAmount; i++) {
+				list.Add(i);
+			}
+
+			list.RemoveRange(2, 5);
+			Assert::IsTrue(list.Count() == addedAmount - 3);
+			Assert::IsTrue(list[1] == 1 && list[2] == 5 && list[list.Count() - 1] == int(addedAmount) - 1);
+
+			//empty range
+			list.RemoveRange(3, 3);
+			Assert::IsTrue(list.Count() == addedAmount - 3);
+
+			Assert::ExpectException<std::out_of_range>([&]() { list.RemoveRange(3, list.Count() + 1); });
+			Assert::ExpectException<std::out_of_range>([&]() { list.RemoveRange(3, 2); });
+
+			list.RemoveRange(0, list.Count());
+			Assert::IsTrue(list.Count() == 0);
+		}
+
+		TEST_METHOD(RemoveAtMany_FundamentalTypes) {
+			List<int> list;
+
+			size_t addedAmount = 10;
+
+			for (size_t i = 0; i < addedAmount; i++) {
+				list.Add(i);
+			}
+
+			//unsorted with duplicates
+			Assert::IsTrue(list.RemoveAtMany({ 7, 1, 3, 7, 0 }) == 4);
+			int expected[] = { 2, 4, 5, 6, 8, 9 };
+			Assert::IsTrue(list.Count() == 6);
+			for (size_t i = 0; i < 6; i++) {
+				Assert::IsTrue(list[i] == expected[i]);
+			}
+
+			//already sorted, from another List
+			List<size_t> indices;
+			indices.Add(size_t(0));
+			indices.Add(size_t(5));
+			Assert::IsTrue(list.RemoveAtMany(indices) == 2);
+			Assert::IsTrue(list.Count() == 4 && list[0] == 4 && list[3] == 8);
+
+			//out of range index - nothing is removed
+			Assert::ExpectException<std::out_of_range>([&]() { list.RemoveAtMany({ 1, 4 }); });
+			Assert::IsTrue(list.Count() == 4);
+
+			Assert::IsTrue(list.RemoveAtMany(List<size_t>()) == 0);
+		}
+
+		TEST_METHOD(RemoveAtMany_ClassTypes) {
+			List<string> list;
+
+			string addedElements[] = { "hi", ",", "bob", "by", "!", "tot" };
+
+			for (size_t i = 0; i < 6; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			Assert::IsTrue(list.RemoveAtMany({ 5, 1, 3 }) == 3);
+			Assert::IsTrue(list.Count() == 3);
+			Assert::IsTrue(list[0] == "hi" && list[1] == "bob" && list[2] == "!");
+		}
+
+		TEST_METHOD(RemoveByMask_FundamentalTypes) {
+			List<int> list;
+			List<bool> mask;
+
+			size_t addedAmount = 10;
+
+			for (size_t i = 0; i < addedAmount; i++) {
+				list.Add(i);
+				mask.Add(i % 2 == 1);
+			}
+
+			Assert::IsTrue(list.RemoveByMask(mask) == addedAmount / 2);
+			for (size_t i = 0; i < list.Count(); i++) {
+				Assert::IsTrue(list[i] == int(i) * 2);
+			}
+
+			List<bool> noneMask;
+			for (size_t i = 0; i < list.Count(); i++) {
+				noneMask.Add(false);
+			}
+			Assert::IsTrue(list.RemoveByMask(noneMask) == 0);
+		}
+
+		TEST_METHOD(UniqueDedup_FundamentalTypes) {
+			List<int> list;
+			int values[] = { 1, 1, 2, 3, 3, 3, 1, 4, 4 };
+			for (int value : values) {
+				list.Add(value);
+			}
+
+			List<int> unique(list);
+			Assert::IsTrue(unique.Unique() == 4);
+			int expectedUnique[] = { 1, 2, 3, 1, 4 };
+			Assert::IsTrue(unique.Count() == 5 && std::equal(unique.begin(), unique.end(), expectedUnique));
+			Assert::IsTrue(unique.Unique() == 0);
+
+			Assert::IsTrue(list.Dedup() == 5);
+			int expectedDedup[] = { 1, 2, 3, 4 };
+			Assert::IsTrue(list.Count() == 4 && std::equal(list.begin(), list.end(), expectedDedup));
+
+			List<int> empty;
+			Assert::IsTrue(empty.Unique() == 0 && empty.Dedup() == 0);
+		}
+
+		TEST_METHOD(UniqueDedup_ClassTypes) {
+			List<string> list;
+			string addedElements[] = { "hi", "Hi", ",", "bob", "hi", ",", "BOB" };
+			for (size_t i = 0; i < 7; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			//custom equality: case-insensitive first letter
+			List<string> unique(list);
+			Assert::IsTrue(unique.Unique([](const string& a, const string& b) { return tolower(a[0]) == tolower(b[0]); }) == 1);
+			Assert::IsTrue(unique.Count() == 6 && unique[0] == "hi" && unique[1] == ",");
+
+			Assert::IsTrue(list.Dedup() == 2);
+			Assert::IsTrue(list.Count() == 5);
+			Assert::IsTrue(list[0] == "hi" && list[1] == "Hi" && list[2] == "," && list[3] == "bob" && list[4] == "BOB");
+		}
+
+		TEST_METHOD(AddRange_FundamentalTypes) {
+			List<int> list;
+			int values[] = { 1, 2, 3 };
+			list.AddRange(values, values + 3);
+			Assert::IsTrue(list.Count() == 3 && list[2] == 3);
+
+			//source inside the list itself, forcing a reallocation
+			list.ShrinkToFit();
+			list.AddRange(list.begin(), list.end());
+			Assert::IsTrue(list.Count() == 6 && list[3] == 1 && list[5] == 3);
+		}
+
 		TEST_METHOD(Iterator) {
 			List<int> list;
 
@@ -387,4 +687,1631 @@ namespace GenericListTest
 
 		}
 	};
+
+	TEST_CLASS(CowListTests)
+	{
+	public:
+
+		TEST_METHOD(CopyShares_ClassTypes) {
+			CowList<string> list;
+			list.Add("hi");
+			list.Add("bob");
+
+			//copies share the same buffer until mutated
+			CowList<string> copy(list);
+			CowList<string> copy2 = copy;
+			Assert::IsTrue(list.UseCount() == 3);
+			Assert::IsTrue(&copy.cbegin()[0] == &list.cbegin()[0]);
+
+			//reads through a const handle never detach
+			const CowList<string>& constCopy = copy2;
+			Assert::IsTrue(constCopy[1] == "bob");
+			Assert::IsTrue(constCopy.Find("hi") != nullptr);
+			Assert::IsTrue(list.UseCount() == 3);
+		}
+
+		TEST_METHOD(DetachOnMutation_ClassTypes) {
+			CowList<string> list;
+			list.Add("hi");
+			list.Add("bob");
+
+			CowList<string> copy(list);
+			copy.Add("tot");
+			Assert::IsTrue(list.Count() == 2 && copy.Count() == 3);
+			Assert::IsTrue(list.UseCount() == 1 && copy.UseCount() == 1);
+
+			CowList<string> copy2(list);
+			copy2[0] = "by";
+			Assert::IsTrue(std::as_const(list)[0] == "hi" && copy2[0] == "by");
+
+			CowList<string> copy3(list);
+			copy3.RemoveAt(0);
+			Assert::IsTrue(list.Count() == 2 && copy3.Count() == 1);
+			Assert::ExpectException<std::out_of_range>([&]() { copy3.RemoveAt(1); });
+
+			//RemoveIf without any match keeps sharing
+			CowList<string> copy4(list);
+			Assert::IsTrue(copy4.Remove("!") == 0);
+			Assert::IsTrue(list.IsShared());
+			Assert::IsTrue(copy4.Remove("hi") == 1);
+			Assert::IsFalse(list.IsShared());
+			Assert::IsTrue(list.Count() == 2 && copy4.Count() == 1);
+
+			CowList<string> copy5(list);
+			for (auto& e : copy5) {
+				e += "!";
+			}
+			Assert::IsTrue(list[1] == "bob" && copy5[1] == "bob!");
+		}
+
+		TEST_METHOD(ConstructorsAssignements_FundamentalTypes) {
+			List<int> source;
+			source.Add(5);
+
+			CowList<int> list(source);
+			Assert::IsTrue(std::as_const(list)[0] == 5);
+			Assert::IsFalse(&std::as_const(list)[0] == &source[0]);
+
+			CowList<int> list2;
+			list2 = list;
+			Assert::IsTrue(list2.UseCount() == 2);
+
+			CowList<int> list3(std::move(list));
+			Assert::IsTrue(list3[0] == 5 && list.Count() == 0);
+
+			CowList<int> list4;
+			list4 = std::move(list3);
+			Assert::IsTrue(list4[0] == 5);
+			Assert::IsTrue(list4.ToList().Count() == 1);
+
+			list4.Clear();
+			Assert::IsTrue(list4.Count() == 0 && list2.Count() == 1);
+		}
+
+		TEST_METHOD(MutableReferenceUnshares_FundamentalTypes) {
+			CowList<int> list;
+			list.Add(1);
+			list.Add(2);
+
+			//a reference taken while unshared must not write into later copies
+			int& first = list[0];
+			CowList<int> copy(list);
+			Assert::IsTrue(!list.IsShared() && copy.UseCount() == 1);
+			first = 10;
+			Assert::IsTrue(std::as_const(copy)[0] == 1 && std::as_const(list)[0] == 10);
+
+			//the copy itself still shares until its own references are handed out
+			CowList<int> copy2(copy);
+			Assert::IsTrue(copy.UseCount() == 2);
+
+			//a mutation after non-const iteration invalidates the references, so copies share again
+			for (auto& e : list) e += 1;
+			CowList<int> unshared(list);
+			Assert::IsTrue(list.UseCount() == 1);
+			list.Add(3);
+			CowList<int> shared(list);
+			Assert::IsTrue(list.UseCount() == 2 && shared.Count() == 3);
+		}
+
+		TEST_METHOD(RemoveIfCallsPredicateOnce_FundamentalTypes) {
+			CowList<int> list;
+			for (int i = 0; i < 10; i++) list.Add(i);
+			CowList<int> copy(list);
+
+			size_t calls = 0;
+			Assert::IsTrue(copy.RemoveIf([&](int e) { ++calls; return e % 3 == 0; }) == 4);
+			Assert::IsTrue(calls == 10 && copy.Count() == 6 && copy.View()[0] == 1 && list.Count() == 10);
+		}
+
+		template <typename U>
+		struct TaggedAllocator {
+			using value_type = U;
+			int tag;
+
+			TaggedAllocator(int tag = 0) : tag(tag) {}
+			template <typename V>
+			TaggedAllocator(const TaggedAllocator<V>& other) : tag(other.tag) {}
+
+			U* allocate(size_t n) { return std::allocator<U>().allocate(n); }
+			void deallocate(U* ptr, size_t n) { std::allocator<U>().deallocate(ptr, n); }
+			bool operator==(const TaggedAllocator& other) const { return tag == other.tag; }
+			bool operator!=(const TaggedAllocator& other) const { return tag != other.tag; }
+		};
+
+		TEST_METHOD(ClearKeepsAllocator_FundamentalTypes) {
+			CowList<int, TaggedAllocator<int>> list(TaggedAllocator<int>(7));
+			list.Add(1);
+
+			CowList<int, TaggedAllocator<int>> copy(list);
+			list.Clear();
+			Assert::IsTrue(list.Count() == 0 && copy.Count() == 1);
+			Assert::IsTrue(list.View().GetAllocator().tag == 7);
+		}
+	};
+
+	TEST_CLASS(ListViewTests)
+	{
+	public:
+
+		TEST_METHOD(Conversions_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 10; i++) {
+				list.Add(i);
+			}
+
+			ListView<int> view = list;
+			Assert::IsTrue(view.Count() == list.Count());
+			Assert::IsTrue(view.begin() == list.begin()); //no copy
+
+			const List<int>& constList = list;
+			ListView<int> constView(constList);
+			Assert::IsTrue(constView.begin() == list.begin());
+
+			int array[] = { 4, 5, 6 };
+			ListView<int> arrayView(array);
+			Assert::IsTrue(arrayView.Count() == 3 && arrayView[2] == 6);
+
+			ListSpan<int> span(list.begin() + 2, 3);
+			ListView<int> spanView = span;
+			Assert::IsTrue(spanView.Count() == 3 && spanView[0] == 2);
+		}
+
+		TEST_METHOD(Slice_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 10; i++) {
+				list.Add(i);
+			}
+
+			ListView<int> view = list;
+			auto slice = view.Slice(3, 4);
+			Assert::IsTrue(slice.Count() == 4 && slice[0] == 3 && slice.Get(3) == 6);
+			Assert::ExpectException<std::out_of_range>([&]() { slice.Get(4); });
+
+			//nested slices, clamped at the end
+			auto nested = slice.Slice(2, 100);
+			Assert::IsTrue(nested.Count() == 2 && nested[0] == 5);
+			Assert::IsTrue(view.Slice(10).IsEmpty());
+			Assert::ExpectException<std::out_of_range>([&]() { view.Slice(11, 1); });
+
+			Assert::IsTrue(slice.Find(5) - slice.begin() == 2);
+			Assert::IsTrue(slice.Find(8) == nullptr);
+			Assert::IsTrue(slice.FindIf([](int e) { return e > 4; }) == list.begin() + 5);
+			Assert::IsTrue(slice.CountIf([](int e) { return e % 2 == 0; }) == 2);
+
+			auto copy = slice.ToList();
+			Assert::IsTrue(copy.Count() == 4 && copy[0] == 3);
+		}
+
+		TEST_METHOD(Span_ClassTypes) {
+			List<string> list;
+			string addedElements[] = { "hi", ",", "bob", "hi" };
+			for (size_t i = 0; i < 4; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			ListSpan<string> span = list;
+			for (auto& e : span.Slice(1, 2)) {
+				e += "!";
+			}
+			Assert::IsTrue(list[0] == "hi" && list[1] == ",!" && list[2] == "bob!" && list[3] == "hi");
+
+			ListView<string> view = span;
+			Assert::IsTrue(view.Count("hi") == 2);
+			Assert::IsTrue(view.Find("bob!") == list.begin() + 2);
+		}
+	};
+
+	TEST_CLASS(LazyListTests)
+	{
+	public:
+
+		TEST_METHOD(FilterMapTake_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 20; i++) {
+				list.Add(i);
+			}
+
+			auto evensSquared = list.Lazy().Filter([](int e) { return e % 2 == 0; }).Map([](int e) { return e * e; }).Collect();
+			Assert::IsTrue(evensSquared.Count() == 10);
+			Assert::IsTrue(evensSquared[3] == 36);
+
+			//Take stops reading the source once enough values are found
+			size_t checks = 0;
+			auto firstOdds = list.Lazy().Filter([&](int e) { ++checks; return e % 2 == 1; }).Take(3).Collect();
+			Assert::IsTrue(firstOdds.Count() == 3 && firstOdds[2] == 5);
+			Assert::IsTrue(checks == 6);
+
+			//result count known up front - destination is pre-sized
+			auto mapped = list.Lazy().Map([](int e) { return double(e) / 2; }).Take(5).Collect();
+			Assert::IsTrue(mapped.Count() == 5 && mapped.Capacity() == 5 && mapped[1] == 0.5);
+
+			Assert::IsTrue(list.Lazy().Take(0).Collect().Count() == 0);
+			Assert::IsTrue(list.Lazy().Filter([](int e) { return e > 15; }).Count() == 4);
+		}
+
+		TEST_METHOD(Reduce_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 100000; i++) {
+				list.Add(i % 100);
+			}
+
+			long long expected = 0;
+			for (int e : list) {
+				if (e % 3 == 0) expected += e;
+			}
+
+			auto pipeline = list.Lazy().Filter([](int e) { return e % 3 == 0; }).Map([](int e) { return (long long)e; });
+			auto plus = [](long long a, long long b) { return a + b; };
+			Assert::IsTrue(pipeline.Reduce(0LL, plus) == expected);
+			Assert::IsTrue(pipeline.Reduce(0LL, plus, LazyExecution::Parallel) == expected);
+
+			auto collected = pipeline.Collect(LazyExecution::Parallel);
+			Assert::IsTrue(collected.Count() == pipeline.Count(LazyExecution::Parallel));
+			for (size_t i = 1; i < collected.Count(); i++) {
+				Assert::IsTrue(collected[i] == (collected[i - 1] + 3) % 102); //still in element order
+			}
+		}
+
+		TEST_METHOD(Pipeline_ClassTypes) {
+			List<string> list;
+			string addedElements[] = { "hi", ",", "bob", "by", "tot" };
+			for (size_t i = 0; i < 5; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			auto lengths = list.Lazy().Filter([](const string& e) { return e.size() > 1; }).Map([](const string& e) { return e + "!"; }).Collect();
+			Assert::IsTrue(lengths.Count() == 4 && lengths[1] == "bob!");
+
+			string joined = ListView<string>(list).Slice(1, 3).Lazy().Reduce(string(), [](string acc, const string& e) { return acc + e; });
+			Assert::IsTrue(joined == ",bobby");
+
+			size_t visited = 0;
+			list.Lazy().Take(2).ForEach([&](const string&) { ++visited; });
+			Assert::IsTrue(visited == 2);
+		}
+
+		TEST_METHOD(ParallelExceptions) {
+			List<int> list;
+			for (int i = 0; i < 1000; i++) {
+				list.Add(i);
+			}
+
+			//thrown on a worker thread, and on the calling thread (first chunk): every thread is joined, then rethrown
+			for (int thrower : { 900, 10 }) {
+				List<int> results;
+				Assert::ExpectException<std::runtime_error>([&]() {
+					lazy_detail::RunChunks(list.begin(), list.end(), 4, results, [&](const int* first, const int* last) {
+						if (thrower >= *first && thrower < *(last - 1)) throw std::runtime_error("chunk failed");
+						return int(last - first);
+					});
+				});
+			}
+
+			//accumulators don't need a default constructor
+			struct Total {
+				explicit Total(long long value) : value(value) {}
+				long long value;
+			};
+			auto total = list.Lazy().Map([](int e) { return Total(e); }).Reduce(Total(0), [](Total acc, const Total& e) { return Total(acc.value + e.value); });
+			Assert::IsTrue(total.value == 999 * 1000 / 2);
+
+			List<Total> chunkTotals;
+			lazy_detail::RunChunks(list.begin(), list.end(), 3, chunkTotals, [](const int* first, const int* last) { return Total(last - first); });
+			Assert::IsTrue(chunkTotals.Count() == 3 && chunkTotals[0].value == 334 && chunkTotals[2].value == 332);
+		}
+	};
+
+	TEST_CLASS(ListReduceTests)
+	{
+	public:
+
+		TEST_METHOD(SumMinMax_FundamentalTypes) {
+			List<int> list;
+			for (int i = 0; i < 1000; i++) {
+				list.Add((i * 37) % 1001 - 500);
+			}
+			list.Add(2000000000);
+			list.Add(2000000000); //int sum overflows, default accumulator doesn't
+
+			long long expected = 0;
+			int min = list[0], max = list[0];
+			for (int e : list) {
+				expected += e;
+				min = std::min(min, e);
+				max = std::max(max, e);
+			}
+
+			Assert::IsTrue(Sum(list) == expected);
+			Assert::IsTrue(Sum(list, LazyExecution::Parallel) == expected);
+			Assert::IsTrue(Min(list) == min);
+			Assert::IsTrue(Max(list) == max);
+			Assert::IsTrue(MinMax(list) == std::make_pair(min, max));
+			Assert::IsTrue(list[ArgMin(list)] == min);
+			Assert::IsTrue(ArgMax(list) == 1000);
+
+			//works on any window, including ones shorter than a vector register
+			ListView<int> view = list;
+			Assert::IsTrue(Sum(view.Slice(1, 3)) == list[1] + list[2] + list[3]);
+			Assert::IsTrue(Min(view.Slice(5, 1)) == list[5]);
+
+			List<int> empty;
+			Assert::IsTrue(Sum(empty) == 0);
+			Assert::ExpectException<std::out_of_range>([&]() { Min(empty); });
+			Assert::ExpectException<std::out_of_range>([&]() { ArgMax(empty); });
+		}
+
+		TEST_METHOD(FloatingPoint_FundamentalTypes) {
+			List<float> floats;
+			List<double> doubles;
+			for (int i = 0; i < 1001; i++) {
+				floats.Add(float(i % 10) * 0.5f);
+				doubles.Add(double(i % 10) * 0.5);
+			}
+
+			Assert::IsTrue(std::abs(Sum(floats) - 2250.0f) < 0.01f);
+			Assert::IsTrue(std::abs(Sum<double>(floats) - 2250.0) < 1e-9);
+			Assert::IsTrue(std::abs(Sum(doubles) - 2250.0) < 1e-9);
+			Assert::IsTrue(Min(floats) == 0.0f && Max(floats) == 4.5f);
+			Assert::IsTrue(Min(doubles) == 0.0 && Max(doubles) == 4.5);
+			Assert::IsTrue(ArgMax(doubles) == 9);
+
+			Assert::IsTrue(std::abs(Mean(doubles, SumMode::Fast) - 2250.0 / 1001) < 1e-9);
+			Assert::IsTrue(std::abs(Mean(doubles, SumMode::Kahan) - 2250.0 / 1001) < 1e-9);
+			Assert::IsTrue(std::abs(Mean(doubles, SumMode::Pairwise) - 2250.0 / 1001) < 1e-9);
+		}
+
+		TEST_METHOD(Variance_FundamentalTypes) {
+			//large offset: a one-pass sum-of-squares would lose every significant digit here
+			List<double> list;
+			for (int i = 0; i < 10000; i++) {
+				list.Add(1e9 + (i % 2 == 0 ? 1.0 : -1.0));
+			}
+
+			Assert::IsTrue(std::abs(Variance(list, SumMode::Kahan) - 1.0) < 1e-6);
+			Assert::IsTrue(std::abs(Variance(list, SumMode::Pairwise) - 1.0) < 1e-6);
+
+			List<int> ints;
+			ints.Add(2);
+			ints.Add(4);
+			ints.Add(4);
+			ints.Add(4);
+			ints.Add(5);
+			ints.Add(5);
+			ints.Add(7);
+			ints.Add(9);
+			Assert::IsTrue(Mean(ints) == 5.0);
+			Assert::IsTrue(Variance(ints) == 4.0);
+		}
+	};
+
+	TEST_CLASS(ListSortTests)
+	{
+	public:
+
+		TEST_METHOD(RadixSort_FundamentalTypes) {
+			List<int> list;
+			unsigned state = 12345;
+			for (int i = 0; i < 5000; i++) {
+				state = state * 1103515245u + 12345u;
+				list.Add(int(state) / 7); //negative and positive values
+			}
+
+			List<int> sequential(list);
+			sequential.Sort();
+			Assert::IsTrue(std::is_sorted(sequential.begin(), sequential.end()));
+
+			List<int> parallel(list);
+			parallel.Sort(LazyExecution::Parallel);
+			Assert::IsTrue(std::equal(sequential.begin(), sequential.end(), parallel.begin()));
+
+			std::sort(list.begin(), list.end());
+			Assert::IsTrue(std::equal(sequential.begin(), sequential.end(), list.begin()));
+
+			List<uint64_t> wide;
+			for (uint64_t i = 0; i < 3000; i++) {
+				wide.Add((i * 0x9E3779B97F4A7C15ull) >> (i % 40));
+			}
+			wide.Sort();
+			Assert::IsTrue(std::is_sorted(wide.begin(), wide.end()));
+		}
+
+		TEST_METHOD(RadixSort_FloatingPoint) {
+			List<float> list;
+			for (int i = 0; i < 4000; i++) {
+				list.Add(float((i * 7919) % 4001 - 2000) / 3.0f);
+			}
+			list.Add(-0.0f);
+			list.Add(std::numeric_limits<float>::infinity());
+			list.Add(-std::numeric_limits<float>::infinity());
+
+			list.Sort();
+			Assert::IsTrue(std::is_sorted(list.begin(), list.end()));
+			Assert::IsTrue(list[0] == -std::numeric_limits<float>::infinity());
+			Assert::IsTrue(list[list.Count() - 1] == std::numeric_limits<float>::infinity());
+
+			List<double> small;
+			small.Add(2.5);
+			small.Add(-1.0);
+			small.Add(0.0);
+			small.Sort();
+			Assert::IsTrue(small[0] == -1.0 && small[1] == 0.0 && small[2] == 2.5);
+		}
+
+		TEST_METHOD(RadixSort_LongDouble) {
+			//wider than 64 bits - must not go through the radix sort
+			List<long double> list;
+			List<int> ids;
+			unsigned state = 11;
+			for (int i = 0; i < 5000; i++) {
+				state = state * 1103515245u + 12345u;
+				list.Add((long double)(int(state >> 4) - (1 << 26)) / 3);
+				ids.Add(int(state >> 16));
+			}
+
+			list.Sort(LazyExecution::Parallel);
+			Assert::IsTrue(std::is_sorted(list.begin(), list.end()));
+
+			ids.SortByKey([](int e) { return -(long double)e; });
+			Assert::IsTrue(std::is_sorted(ids.begin(), ids.end(), std::greater<>()));
+		}
+
+		TEST_METHOD(SortByKey_ClassTypes) {
+			struct Entry {
+				int id;
+				string name;
+			};
+
+			List<Entry> list;
+			for (int i = 0; i < 3000; i++) {
+				list.Add(Entry{ (i * 31) % 100 - 50, std::to_string(i) });
+			}
+
+			list.SortByKey([](const Entry& e) { return e.id; });
+			for (size_t i = 1; i < list.Count(); i++) {
+				Assert::IsTrue(list[i - 1].id <= list[i].id);
+				if (list[i - 1].id == list[i].id) { //stable: equal keys keep insertion order
+					Assert::IsTrue(std::stoi(list[i - 1].name) < std::stoi(list[i].name));
+				}
+			}
+
+			List<string> strings;
+			strings.Add("bob");
+			strings.Add("hi");
+			strings.Add(",");
+			strings.SortByKey([](const string& s) { return s.size(); }, LazyExecution::Parallel);
+			Assert::IsTrue(strings[0] == "," && strings[1] == "hi" && strings[2] == "bob");
+		}
+
+		TEST_METHOD(Sort_FundamentalTypes) {
+			//random, sorted, reversed, few unique, organ pipe - at sizes around the network/insertion/ninther thresholds
+			size_t sizes[] = { 0, 1, 2, 5, 17, 24, 32, 33, 100, 129, 1000, 20000 };
+			for (size_t size : sizes) {
+				for (int pattern = 0; pattern < 5; pattern++) {
+					List<int> list;
+					unsigned state = unsigned(size) * 7 + unsigned(pattern);
+					for (size_t i = 0; i < size; i++) {
+						state = state * 1103515245u + 12345u;
+						int values[] = { int(state >> 8), int(i), -int(i), int(state >> 8) % 4, int(i < size / 2 ? i : size - i) };
+						list.Add(values[pattern]);
+					}
+
+					List<int> expected(list);
+					std::sort(expected.begin(), expected.end(), std::greater<>());
+
+					list.Sort(std::greater<>());
+					Assert::IsTrue(std::equal(expected.begin(), expected.end(), list.begin()));
+
+					List<int> stable(expected);
+					std::reverse(stable.begin(), stable.end());
+					stable.StableSort(std::greater<>());
+					Assert::IsTrue(std::equal(expected.begin(), expected.end(), stable.begin()));
+				}
+			}
+		}
+
+		TEST_METHOD(Sort_ClassTypes) {
+			List<string> list;
+			unsigned state = 1;
+			for (int i = 0; i < 5000; i++) {
+				state = state * 1103515245u + 12345u;
+				list.Add(std::to_string(state % 1000));
+			}
+
+			List<string> expected(list);
+			std::sort(expected.begin(), expected.end());
+
+			List<string> sorted(list);
+			sorted.Sort();
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), sorted.begin()));
+
+			sorted.Sort([](const string& a, const string& b) { return a > b; });
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), std::make_reverse_iterator(sorted.end())));
+
+			//stable: sort by length only, equal lengths keep their original order
+			List<string> stable(list);
+			stable.StableSort([](const string& a, const string& b) { return a.size() < b.size(); });
+			List<string> expectedStable(list);
+			std::stable_sort(expectedStable.begin(), expectedStable.end(), [](const string& a, const string& b) { return a.size() < b.size(); });
+			Assert::IsTrue(std::equal(expectedStable.begin(), expectedStable.end(), stable.begin()));
+		}
+	};
+
+	TEST_CLASS(ListSetTests)
+	{
+	public:
+
+		TEST_METHOD(SetOperationsInPlace_ClassTypes) {
+			List<string> a, b;
+			string aValues[] = { "a", "c", "e" };
+			string bValues[] = { "b", "c", "d" };
+			for (const auto& value : aValues) a.Add(value);
+			for (const auto& value : bValues) b.Add(value);
+
+			//dest is one of the inputs
+			List<string> united(a);
+			Assert::IsTrue(Union(united, b, united) == 5);
+			Assert::IsTrue(united[0] == "a" && united[2] == "c" && united[4] == "e");
+
+			List<string> common(b);
+			Assert::IsTrue(Intersect(a, common, common) == 1 && common[0] == "c");
+
+			List<string> left(a);
+			Assert::IsTrue(Difference(left, b, left) == 2 && left[1] == "e");
+			Assert::IsTrue(SymmetricDifference(left, left, left) == 0 && left.Count() == 0);
+
+			//a window into dest
+			List<string> merged(a);
+			Assert::IsTrue(Merge(ListView<string>(merged).Slice(1), ListView<string>(b), merged) == 5);
+			Assert::IsTrue(merged[0] == "b" && merged[4] == "e");
+		}
+
+		TEST_METHOD(SetOperations_FundamentalTypes) {
+			List<int> a, b, dest;
+			int aValues[] = { 1, 2, 2, 2, 4, 6, 8 };
+			int bValues[] = { 2, 2, 3, 4, 9 };
+			for (int value : aValues) a.Add(value);
+			for (int value : bValues) b.Add(value);
+
+			//same results as the std::set_* algorithms
+			auto check = [&](size_t written, auto stdAlgorithm) {
+				List<int> expected;
+				for (size_t i = 0; i < a.Count() + b.Count(); i++) {
+					expected.Add(0);
+				}
+				int* expectedEnd = stdAlgorithm(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+				Assert::IsTrue(written == dest.Count());
+				Assert::IsTrue(size_t(expectedEnd - expected.begin()) == dest.Count());
+				Assert::IsTrue(std::equal(dest.begin(), dest.end(), expected.begin()));
+			};
+
+			check(Merge(a, b, dest), [](auto... args) { return std::merge(args...); });
+			check(Union(a, b, dest), [](auto... args) { return std::set_union(args...); });
+			check(Intersect(a, b, dest), [](auto... args) { return std::set_intersection(args...); });
+			check(Difference(a, b, dest), [](auto... args) { return std::set_difference(args...); });
+			check(SymmetricDifference(a, b, dest), [](auto... args) { return std::set_symmetric_difference(args...); });
+		}
+
+		TEST_METHOD(IntersectGalloping_FundamentalTypes) {
+			List<int> big, small, dest;
+			for (int i = 0; i < 10000; i++) {
+				big.Add(i * 3);
+			}
+			int smallValues[] = { -1, 0, 3, 4, 2999, 3000, 29997, 40000 };
+			for (int value : smallValues) small.Add(value);
+
+			Assert::IsTrue(Intersect(small, big, dest) == 4);
+			Assert::IsTrue(dest[0] == 0 && dest[1] == 3 && dest[2] == 3000 && dest[3] == 29997);
+
+			Assert::IsTrue(Intersect(big, small, dest) == 4);
+			Assert::IsTrue(dest[0] == 0 && dest[3] == 29997);
+
+			//works on windows too
+			ListView<int> view = big;
+			Assert::IsTrue(Intersect(ListView<int>(small), view.Slice(0, 1001), dest) == 3);
+		}
+
+		TEST_METHOD(SetOperations_ClassTypes) {
+			List<string> a, b, dest;
+			string aValues[] = { "bob", "hi", "tot" };
+			string bValues[] = { ",", "hi" };
+			for (const auto& value : aValues) a.Add(value);
+			for (const auto& value : bValues) b.Add(value);
+
+			Assert::IsTrue(Union(a, b, dest) == 4 && dest[0] == ",");
+			Assert::IsTrue(Intersect(a, b, dest) == 1 && dest[0] == "hi");
+			Assert::IsTrue(Difference(a, b, dest) == 2 && dest[1] == "tot");
+
+			//descending order with a custom comp
+			std::reverse(a.begin(), a.end());
+			std::reverse(b.begin(), b.end());
+			Assert::IsTrue(Merge(a, b, dest, std::greater<>()) == 5 && dest[0] == "tot" && dest[4] == ",");
+		}
+	};
+
+	TEST_CLASS(BitListTests)
+	{
+	public:
+
+		TEST_METHOD(AddGetSet) {
+			BitList list;
+			for (size_t i = 0; i < 150; i++) {
+				list.Add(i % 3 == 0);
+			}
+
+			Assert::IsTrue(list.Count() == 150);
+			Assert::IsTrue(list.WordCount() == 3);
+			Assert::IsTrue(list[0] && !list[1] && list.Get(147) && !list.Get(149));
+			Assert::ExpectException<std::out_of_range>([&]() { list.Get(150); });
+
+			list.Set(1, true);
+			list.Set(0, false);
+			Assert::IsTrue(!list[0] && list[1]);
+			Assert::ExpectException<std::out_of_range>([&]() { list.Set(150, true); });
+
+			Assert::IsTrue(list.CountSet() == 50);
+		}
+
+		TEST_METHOD(AddWord) {
+			BitList bits;
+			bits.AddWord(0b101, 3);
+			bits.AddWord(~uint64_t(0), 64);
+			bits.AddWord(0xFF, 4);
+			Assert::IsTrue(bits.Count() == 71 && bits.CountSet() == 2 + 64 + 4);
+			Assert::IsTrue(bits[0] && !bits[1] && bits[2] && bits[66] && bits[70]);
+
+			//no flags added, the word count follows the flag count
+			BitList aligned;
+			aligned.AddWord(~uint64_t(0), 0);
+			aligned.AddWord(~uint64_t(0), 64);
+			aligned.AddWord(~uint64_t(0), 0);
+			Assert::IsTrue(aligned.Count() == 64 && aligned.WordCount() == 1);
+			Assert::ExpectException<std::invalid_argument>([&]() { aligned.AddWord(0, 65); });
+		}
+
+		TEST_METHOD(FindSet) {
+			BitList list(200, false);
+			Assert::IsTrue(list.FindFirstSet() == BitList::npos);
+
+			list.Set(70, true);
+			list.Set(130, true);
+			list.Set(199, true);
+			Assert::IsTrue(list.FindFirstSet() == 70);
+			Assert::IsTrue(list.FindNextSet(71) == 130);
+			Assert::IsTrue(list.FindNextSet(131) == 199);
+			Assert::IsTrue(list.FindNextSet(200) == BitList::npos);
+
+			size_t visited[3];
+			size_t amount = 0;
+			list.ForEachSet([&](size_t index) { visited[amount++] = index; });
+			Assert::IsTrue(amount == 3 && visited[0] == 70 && visited[1] == 130 && visited[2] == 199);
+		}
+
+		TEST_METHOD(BulkOperations) {
+			BitList a, b;
+			for (size_t i = 0; i < 100; i++) {
+				a.Add(i % 2 == 0);
+				b.Add(i % 3 == 0);
+			}
+
+			Assert::IsTrue((a & b).CountSet() == 17); //multiples of 6 below 100
+			Assert::IsTrue((a | b).CountSet() == 50 + 34 - 17);
+			Assert::IsTrue((a ^ b).CountSet() == 50 + 34 - 2 * 17);
+
+			//NOT doesn't set the unused bits of the last word
+			Assert::IsTrue((~a).CountSet() == 50);
+			Assert::IsTrue(BitList(70, true).CountSet() == 70);
+			BitList none(70, true);
+			none.Not();
+			Assert::IsTrue(none.CountSet() == 0);
+
+			BitList shorter(99, false);
+			Assert::ExpectException<std::invalid_argument>([&]() { a &= shorter; });
+		}
+
+		TEST_METHOD(RemoveByMask_ClassTypes) {
+			List<string> list;
+			BitList mask;
+			for (size_t i = 0; i < 200; i++) {
+				list.Add(std::to_string(i));
+				mask.Add(i >= 130 && i % 10 == 0);
+			}
+
+			Assert::IsTrue(list.RemoveByMask(mask) == 7);
+			Assert::IsTrue(list.Count() == 193);
+			Assert::IsTrue(list[129] == "129" && list[130] == "131" && list.Find("190") == nullptr);
+
+			BitList empty(list.Count(), false);
+			Assert::IsTrue(list.RemoveByMask(empty) == 0);
+		}
+	};
+
+	TEST_CLASS(StringListTests)
+	{
+	public:
+
+		TEST_METHOD(AddFindRemove) {
+			StringList list;
+			string addedElements[] = { "hi", ",", "bob", "hi" };
+			for (size_t i = 0; i < 4; i++) {
+				list.Add(addedElements[i]);
+			}
+
+			Assert::IsTrue(list.Count() == 4);
+			Assert::IsTrue(list.ArenaBytes() == 8);
+			Assert::IsTrue(list[2] == "bob" && list.Get(1) == ",");
+			Assert::ExpectException<std::out_of_range>([&]() { list.Get(4); });
+
+			Assert::IsTrue(list.Find("bob") == 2);
+			Assert::IsTrue(list.Find("by") == StringList::npos);
+
+			Assert::IsTrue(list.Remove("hi") == 2);
+			Assert::IsTrue(list.Count() == 2 && list[0] == "," && list[1] == "bob");
+
+			list.RemoveAt(0);
+			Assert::IsTrue(list.Count() == 1 && list[0] == "bob");
+			Assert::ExpectException<std::out_of_range>([&]() { list.RemoveAt(1); });
+		}
+
+		TEST_METHOD(AppendAndCompact) {
+			StringList list;
+			list.Add("List");
+			list.Add("<T>");
+
+			//last element grows in place
+			list.Append(1, "[processed]");
+			Assert::IsTrue(list[1] == "<T>[processed]");
+			Assert::IsTrue(list.DeadBytes() == 0);
+
+			//other elements are relocated to the tail
+			list.Append(0, "[processed]");
+			Assert::IsTrue(list[0] == "List[processed]" && list[1] == "<T>[processed]");
+			Assert::IsTrue(list.DeadBytes() == 4);
+
+			//appending an element to itself
+			list.Append(1, list[1]);
+			Assert::IsTrue(list[1] == "<T>[processed]<T>[processed]");
+
+			list.Compact();
+			Assert::IsTrue(list.DeadBytes() == 0);
+			Assert::IsTrue(list.ArenaBytes() == 15 + 28);
+			Assert::IsTrue(list[0] == "List[processed]" && list[1] == "<T>[processed]<T>[processed]");
+
+			//removing most of the content compacts automatically
+			list.RemoveIf([](std::string_view e) { return e.size() > 20; });
+			Assert::IsTrue(list.DeadBytes() == 0 && list.ArenaBytes() == 15);
+
+			size_t visited = 0;
+			for (auto e : list) {
+				Assert::IsTrue(e == "List[processed]");
+				++visited;
+			}
+			Assert::IsTrue(visited == 1);
+		}
+	};
+
+
+	TEST_CLASS(StringSearchTests)
+	{
+	public:
+
+		TEST_METHOD(SearcherFind) {
+			for (std::string needle : { std::string(), std::string("a"), std::string("ab"), std::string("[processed]"), std::string(70, 'a') + "b", std::string("abcab") + std::string(80, 'c') + "abcab" }) {
+				SubstringSearcher searcher(needle);
+				for (std::string haystack : { std::string(), std::string("xx[processed]"), std::string(200, 'a'), std::string(100, 'a') + needle + "tail",
+											  std::string(40, 'z') + needle, needle.substr(0, needle.size() / 2) + std::string(30, 'c') + needle }) {
+					Assert::IsTrue(searcher.Find(haystack) == haystack.find(needle));
+				}
+			}
+		}
+
+		TEST_METHOD(SearcherRandom) {
+			//needles over a 3 letter alphabet (periodic ones every third round) against haystacks that mostly miss
+			unsigned state = 38;
+			auto letter = [&]() {
+				state = state * 1103515245u + 12345u;
+				return char('a' + (state >> 8) % 3);
+			};
+			for (size_t round = 0; round < 300; round++) {
+				std::string needle, haystack;
+				const size_t needleSize = round % 2 == 0 ? 2 + round % 7 : 60 + round % 20;
+				for (size_t i = 0; i < needleSize; i++) needle += round % 3 == 0 ? char('a' + i % 2) : letter();
+				for (size_t i = 0; i < 400; i++) haystack += letter();
+				if (round % 4 == 0) haystack.insert(state % haystack.size(), needle);
+
+				Assert::IsTrue(SubstringSearcher(needle).Find(haystack) == haystack.find(needle));
+			}
+		}
+
+		TEST_METHOD(FindAndCountContaining) {
+			List<std::string> list;
+			for (size_t i = 0; i < 100; i++) {
+				list.Add("request " + std::to_string(i) + (i % 3 == 0 ? " [processed]" : ""));
+			}
+
+			List<size_t> indices = FindContaining(list, "[processed]");
+			Assert::IsTrue(indices.Count() == 34 && CountContaining(list, "[processed]") == 34);
+			for (size_t i = 0; i < indices.Count(); i++) {
+				Assert::IsTrue(indices[i] == i * 3);
+			}
+
+			BitList mask = MatchContaining(list, "[processed]", LazyExecution::Parallel);
+			Assert::IsTrue(mask.Count() == 100 && mask.CountSet() == 34 && mask[99] && !mask[98]);
+			Assert::IsTrue(CountContaining(ListView<std::string>(list).Slice(0, 10), "request 1") == 1);
+		}
+
+		TEST_METHOD(RemoveContaining) {
+			List<std::string> list;
+			for (size_t i = 0; i < 10; i++) {
+				list.Add("request " + std::to_string(i) + (i % 2 == 0 ? "[processed]" : ""));
+			}
+
+			List<std::string> copy(list);
+			Assert::IsTrue(RemoveIfNotContains(list, "[processed]") == 5);
+			Assert::IsTrue(list.Count() == 5 && list[4] == "request 8[processed]");
+
+			Assert::IsTrue(RemoveIfContains(copy, "[processed]") == 5);
+			Assert::IsTrue(copy.Count() == 5 && copy[0] == "request 1");
+		}
+	};
+
+
+	TEST_CLASS(PrefixIndexedListTests)
+	{
+	public:
+
+		TEST_METHOD(FindAndCountPrefix) {
+			List<std::string> elements;
+			for (auto e : { "cache/miss", "api/users", "cache/hit", "api/orders", "cache", "static/app.js", "api/users" }) elements.Add(e);
+			PrefixIndexedList list(elements);
+
+			Assert::IsTrue(list.CountPrefix("api/") == 3 && list.CountPrefix("cache") == 3 && list.CountPrefix("x") == 0 && list.CountPrefix("") == 7);
+
+			//lexicographic order, equal values by index
+			List<size_t> indices = list.FindPrefix("api/");
+			Assert::IsTrue(indices.Count() == 3 && indices[0] == 3 && indices[1] == 1 && indices[2] == 6);
+
+			Assert::IsTrue(list.Find("cache") == 4 && list.Find("api/users") == 1 && list.Find("api") == PrefixIndexedList::npos);
+
+			list.Add("api/admin");
+			list.Add("zzz");
+			Assert::IsTrue(list.FindPrefix("api/")[0] == 7 && list.Find("zzz") == 8 && list.CountPrefix("api") == 4);
+		}
+
+		TEST_METHOD(RemoveKeepsIndexInSync) {
+			PrefixIndexedList list;
+			for (size_t i = 0; i < 50; i++) {
+				list.Add((i % 3 == 0 ? "tmp/" : "log/") + std::to_string(i));
+			}
+
+			Assert::IsTrue(list.RemoveIfPrefix("tmp/") == 17);
+			Assert::IsTrue(list.Count() == 33 && list[0] == "log/1" && list[1] == "log/2" && list[2] == "log/4");
+
+			Assert::IsTrue(list.Remove("log/2") == 1 && list.Remove("log/2") == 0);
+			list.RemoveAt(0);
+			Assert::IsTrue(list[0] == "log/4");
+			Assert::ExpectException<std::out_of_range>([&]() { list.RemoveAt(31); });
+
+			//every element is still found at its current index
+			for (size_t i = 0; i < list.Count(); i++) {
+				Assert::IsTrue(list.Find(list[i]) == i);
+			}
+			Assert::IsTrue(list.CountPrefix("log/4") == 8);
+
+			auto sorted = list.Sorted();
+			Assert::IsTrue(std::is_sorted(sorted.begin(), sorted.end(), [&](size_t a, size_t b) { return list[a] < list[b]; }));
+		}
+	};
+
+
+	TEST_CLASS(DictListTests)
+	{
+	public:
+
+		TEST_METHOD(AddFindDecode) {
+			DictList<std::string> list;
+			const char* statuses[] = { "ok", "timeout", "ok", "refused", "ok" };
+			for (size_t i = 0; i < 100; i++) list.Add(statuses[i % 5]);
+
+			Assert::IsTrue(list.Count() == 100 && list.DictionarySize() == 3);
+			Assert::IsTrue(list[3] == "refused" && list.Get(99) == "ok");
+			Assert::ExpectException<std::out_of_range>([&]() { list.Get(100); });
+
+			Assert::IsTrue(list.Find("refused") == 3 && list.Find("missing") == DictList<std::string>::npos);
+			Assert::IsTrue(list.CountOf("ok") == 60 && list.CountOf("timeout") == 20 && list.CountOf("missing") == 0);
+
+			size_t visited = 0;
+			for (const auto& e : list) {
+				Assert::IsTrue(e == statuses[visited % 5]);
+				++visited;
+			}
+			Assert::IsTrue(visited == 100);
+
+			//copies decode against their own dictionary
+			DictList<std::string> copy(list);
+			list.Clear();
+			Assert::IsTrue(copy.Count() == 100 && copy[1] == "timeout" && copy.ToList()[3] == "refused");
+		}
+
+		TEST_METHOD(FindCodeScan) {
+			DictList<int> list;
+			for (int i = 0; i < 1000; i++) list.Add(i % 7 == 6 ? 1 : 0);
+			list.Add(42);
+			Assert::IsTrue(list.Find(42) == 1000 && list.Find(1) == 6);
+
+			list.RemoveAt(1000);
+			Assert::IsTrue(list.Find(42) == DictList<int>::npos && list.DictionarySize() == 3);
+		}
+
+		TEST_METHOD(RemoveOncePerEntry) {
+			DictList<std::string> list;
+			for (size_t i = 0; i < 1000; i++) list.Add("node-" + std::to_string(i % 10));
+
+			size_t calls = 0;
+			size_t removed = list.RemoveIf([&](const std::string& v) {
+				++calls;
+				return v.back() % 2 == 0;
+			});
+			Assert::IsTrue(calls == 10 && removed == 500 && list.Count() == 500);
+			Assert::IsTrue(list[0] == "node-1" && list[1] == "node-3");
+
+			Assert::IsTrue(list.Remove("node-1") == 100 && list.Remove("node-0") == 0);
+			Assert::IsTrue(list.Count() == 400 && list[0] == "node-3");
+		}
+	};
+
+
+	TEST_CLASS(PackedIntListTests)
+	{
+	public:
+
+		TEST_METHOD(SortedIds) {
+			PackedIntList<uint32_t> list;
+			List<uint32_t> raw;
+			uint32_t id = 1000;
+			unsigned state = 41;
+			for (size_t i = 0; i < 1000; i++) {
+				state = state * 1103515245u + 12345u;
+				id += (state >> 8) % 20;
+				list.Add(id);
+				raw.Add(id);
+			}
+
+			Assert::IsTrue(list.Count() == 1000 && list.BlockCount() == 7);
+			Assert::IsTrue(list.MemoryBytes() * 2 < raw.Count() * sizeof(uint32_t));
+			for (size_t i = 0; i < raw.Count(); i++) {
+				Assert::IsTrue(list[i] == raw[i]);
+			}
+			Assert::IsTrue(std::equal(raw.begin(), raw.end(), list.ToList().begin()));
+			Assert::ExpectException<std::out_of_range>([&]() { list.Get(1000); });
+
+			for (size_t i = 0; i < raw.Count(); i += 37) {
+				Assert::IsTrue(list.Find(raw[i]) == size_t(std::find(raw.begin(), raw.end(), raw[i]) - raw.begin()));
+				Assert::IsTrue(list.LowerBound(raw[i] + 1) == size_t(std::lower_bound(raw.begin(), raw.end(), raw[i] + 1) - raw.begin()));
+			}
+			Assert::IsTrue(list.LowerBound(0) == 0 && list.LowerBound(id + 1) == 1000);
+			Assert::IsTrue(list.Find(id + 1) == PackedIntList<uint32_t>::npos && list.Find(999) == PackedIntList<uint32_t>::npos);
+		}
+
+		TEST_METHOD(UnsortedAndWideValues) {
+			PackedIntList<uint64_t> list;
+			List<uint64_t> raw;
+			uint64_t state = 7;
+			for (size_t i = 0; i < 640; i++) {
+				state = state * 6364136223846793005ull + 1442695040888963407ull;
+				//full 64 bit values, constant runs (0 bit blocks) and a narrow unsorted range
+				const uint64_t value = i < 128 ? state : i < 256 ? 5 : i < 384 ? state % 1000 : i < 512 ? ~uint64_t(0) - i : state >> 60;
+				list.Add(value);
+				raw.Add(value);
+			}
+
+			Assert::IsTrue(list.Count() == 640 && list.BlockCount() == 5);
+			size_t i = 0;
+			list.ForEach([&](uint64_t value) {
+				Assert::IsTrue(value == raw[i]);
+				++i;
+			});
+			Assert::IsTrue(i == 640 && list[200] == 5 && list[639] == raw[639]);
+			Assert::IsTrue(list.Find(raw[300]) == size_t(std::find(raw.begin(), raw.end(), raw[300]) - raw.begin()));
+		}
+	};
+
+
+	TEST_CLASS(RleListTests)
+	{
+	public:
+
+		TEST_METHOD(AddGetRuns) {
+			RleList<int> list;
+			list.Add(200, 1000);
+			list.Add(404);
+			list.Add(404);
+			list.Add(200, 500);
+			list.Add(500, 0);
+
+			Assert::IsTrue(list.Count() == 1502 && list.RunCount() == 3);
+			Assert::IsTrue(list[0] == 200 && list[999] == 200 && list[1000] == 404 && list[1001] == 404 && list.Get(1501) == 200);
+			Assert::ExpectException<std::out_of_range>([&]() { list.Get(1502); });
+
+			Assert::IsTrue(list.Find(404) == 1000 && list.Find(500) == RleList<int>::npos);
+			Assert::IsTrue(list.Count(200) == 1500 && list.Count(404) == 2);
+
+			List<int> decoded = list.ToList();
+			RleList<int> encoded(decoded);
+			Assert::IsTrue(decoded.Count() == 1502 && decoded[1001] == 404 && encoded.RunCount() == 3 && encoded.Count() == 1502);
+		}
+
+		TEST_METHOD(RemoveMergesRuns) {
+			RleList<std::string> list;
+			list.Add("a", 3);
+			list.Add("b", 2);
+			list.Add("a", 4);
+			list.Add("c");
+			list.Add("a");
+
+			size_t calls = 0;
+			Assert::IsTrue(list.RemoveIf([&](const std::string& v) { ++calls; return v == "b"; }) == 2);
+			Assert::IsTrue(calls == 5 && list.RunCount() == 3 && list.Count() == 9 && list[8] == "a" && list[7] == "c");
+
+			list.RemoveAt(7);
+			Assert::IsTrue(list.RunCount() == 1 && list.Count() == 8 && list[7] == "a");
+
+			list.RemoveAt(0);
+			Assert::IsTrue(list.RunCount() == 1 && list.Count() == 7);
+			Assert::IsTrue(list.Remove("a") == 7 && list.IsEmpty());
+		}
+	};
+
+
+	TEST_CLASS(CompressedFloatListTests)
+	{
+	public:
+
+		TEST_METHOD(GaugeRoundTrip) {
+			CompressedFloatList list;
+			List<double> raw;
+			unsigned state = 43;
+			double gauge = 50.0;
+			for (size_t i = 0; i < 1000; i++) {
+				state = state * 1103515245u + 12345u;
+				//repeats, small steps, and the odd special value
+				if (i % 3 != 0) gauge = std::round((gauge + double(int((state >> 8) % 21) - 10) / 10.0) * 10.0) / 10.0;
+				const double value = i == 500 ? -0.0 : i == 501 ? 1e300 : i == 502 ? std::numeric_limits<double>::infinity() : gauge;
+				list.Add(value);
+				raw.Add(value);
+			}
+
+			Assert::IsTrue(list.Count() == 1000 && list.MemoryBytes() < raw.Count() * sizeof(double) * 3 / 4);
+			for (size_t i = 0; i < raw.Count(); i++) {
+				Assert::IsTrue(list[i] == raw[i]);
+			}
+			Assert::IsTrue(std::signbit(list[500]) && list.Get(502) == std::numeric_limits<double>::infinity());
+			Assert::ExpectException<std::out_of_range>([&]() { list.Get(1000); });
+
+			size_t i = 0;
+			for (double value : list) {
+				Assert::IsTrue(value == raw[i]);
+				++i;
+			}
+			Assert::IsTrue(i == 1000);
+		}
+
+		TEST_METHOD(Timestamps) {
+			CompressedTimestampList list;
+			List<int64_t> raw;
+			int64_t t = 1700000000000;
+			for (size_t i = 0; i < 600; i++) {
+				//steady 10s interval, jitter, gaps and one jump backwards
+				t += i % 50 == 0 ? 3600000 : i == 300 ? -86400000 : 10000 + int64_t(i % 7) - 3;
+				list.Add(t);
+				raw.Add(t);
+			}
+			list.Add(INT64_MIN);
+			raw.Add(INT64_MIN);
+
+			Assert::IsTrue(list.Count() == 601 && list.MemoryBytes() < raw.Count() * sizeof(int64_t) / 4);
+			for (size_t i = 0; i < raw.Count(); i++) {
+				Assert::IsTrue(list[i] == raw[i]);
+			}
+			List<int64_t> decoded = list.ToList();
+			Assert::IsTrue(std::equal(raw.begin(), raw.end(), decoded.begin()));
+		}
+	};
+
+
+	TEST_CLASS(PersistentVectorTests)
+	{
+	public:
+
+		TEST_METHOD(AddSetShareVersions) {
+			PersistentVector<int> empty;
+			PersistentVector<int> v = empty;
+			List<PersistentVector<int>> versions;
+			for (int i = 0; i < 5000; i++) {
+				v = v.Add(i);
+				if (i % 1000 == 999) versions.Add(v);
+			}
+
+			Assert::IsTrue(empty.IsEmpty() && v.Count() == 5000);
+			for (size_t i = 0; i < versions.Count(); i++) {
+				Assert::IsTrue(versions[i].Count() == (i + 1) * 1000 && versions[i][999] == 999);
+			}
+			for (int i = 0; i < 5000; i++) {
+				Assert::IsTrue(v[i] == i);
+			}
+
+			//Set copies only the path - the old version is untouched
+			PersistentVector<int> changed = v.Set(1234, -1).Set(4999, -2);
+			Assert::IsTrue(changed[1234] == -1 && changed[4999] == -2 && v[1234] == 1234 && v[4999] == 4999);
+			Assert::ExpectException<std::out_of_range>([&]() { v.Get(5000); });
+			Assert::ExpectException<std::out_of_range>([&]() { v.Set(5000, 0); });
+
+			List<int> list = changed.ToList();
+			Assert::IsTrue(list.Count() == 5000 && list[1234] == -1 && list[1235] == 1235);
+		}
+
+		TEST_METHOD(SliceAndRemove) {
+			List<int> source;
+			for (int i = 0; i < 2000; i++) source.Add(i);
+			PersistentVector<int> v(source);
+
+			PersistentVector<int> slice = v.Slice(100, 50);
+			Assert::IsTrue(slice.Count() == 50 && slice[0] == 100 && slice[49] == 149);
+
+			//appending to a slice overwrites nothing in the original
+			PersistentVector<int> grown = slice;
+			for (int i = 0; i < 100; i++) grown = grown.Add(-i);
+			Assert::IsTrue(grown.Count() == 150 && grown[49] == 149 && grown[50] == 0 && grown[149] == -99);
+			Assert::IsTrue(v[150] == 150 && v.Count() == 2000);
+
+			PersistentVector<int> removed = v.RemoveAt(0).RemoveAt(1998).RemoveAt(500);
+			Assert::IsTrue(removed.Count() == 1997 && removed[0] == 1 && removed[499] == 500 && removed[500] == 502 && removed[1996] == 1998);
+			Assert::IsTrue(v.Slice(2000).IsEmpty() && v.Slice(1990, 100).Count() == 10);
+			Assert::ExpectException<std::out_of_range>([&]() { v.Slice(2001); });
+
+			int expected = 1;
+			removed.Slice(0, 10).ForEach([&](int e) { Assert::IsTrue(e == expected++); });
+		}
+
+		TEST_METHOD(Transient) {
+			PersistentVector<std::string> base;
+			base = base.Add("a").Add("b");
+
+			auto builder = base.Transient();
+			for (int i = 0; i < 100; i++) builder.Add(std::to_string(i));
+			builder.Set(0, "z");
+			PersistentVector<std::string> first = builder.Persistent();
+
+			//edits after publishing don't leak into the published version
+			builder.Set(50, "changed");
+			builder.Add("last");
+			PersistentVector<std::string> second = builder.Persistent();
+
+			Assert::IsTrue(base.Count() == 2 && base[0] == "a");
+			Assert::IsTrue(first.Count() == 102 && first[0] == "z" && first[50] == "48" && first[101] == "99");
+			Assert::IsTrue(second.Count() == 103 && second[50] == "changed" && second[102] == "last");
+			Assert::IsTrue(builder.ToList().Count() == 103);
+		}
+	};
+
+
+	TEST_CLASS(RcuListTests)
+	{
+	public:
+
+		TEST_METHOD(SnapshotsOutliveChanges) {
+			RcuList<std::string> list;
+			list.Add("a");
+			list.Add("b");
+
+			auto before = list.Read();
+			for (int i = 0; i < 100; i++) list.Add(std::to_string(i));
+			Assert::IsTrue(list.RemoveIf([](const std::string& e) { return e.size() == 1; }) == 12);
+
+			//the first snapshot still sees its buffer, a new one sees the changes
+			Assert::IsTrue(before.Count() == 2 && before[1] == "b" && before.Find("a") != nullptr);
+			Assert::IsTrue(list.RetiredCount() > 0);
+			{
+				auto after = list.Read();
+				Assert::IsTrue(after.Count() == 90 && after[0] == "10" && after.Find("a") == nullptr);
+				Assert::IsTrue(after.FindIf([](const std::string& e) { return e == "99"; }) == after.end() - 1);
+			}
+
+			Assert::IsTrue(list.Remove("50") == 1 && list.Count() == 89);
+			Assert::IsTrue(list.RetiredCount() > 0);
+
+			size_t calls = 0;
+			Assert::IsTrue(list.RemoveIf([&](const std::string& e) { ++calls; return e == "20" || e == "21"; }) == 2);
+			Assert::IsTrue(calls == 89 && list.Count() == 87);
+		}
+
+		TEST_METHOD(ReclaimsAfterReaders) {
+			RcuList<int> list;
+			{
+				auto snapshot = list.Read();
+				for (int i = 0; i < 1000; i++) list.Add(i);
+				Assert::IsTrue(list.RetiredCount() > 0 && snapshot.IsEmpty());
+			}
+			list.Reclaim();
+			Assert::IsTrue(list.RetiredCount() == 0 && list.Count() == 1000);
+			list.Clear();
+			Assert::IsTrue(list.Count() == 0 && list.RetiredCount() == 0);
+		}
+
+		TEST_METHOD(ConcurrentReaders) {
+			RcuList<int> list;
+			std::atomic<bool> done(false);
+			std::atomic<size_t> torn(0);
+
+			//the writer only ever holds increasing values, so every snapshot must be sorted
+			List<std::thread> readers;
+			for (int r = 0; r < 4; r++) {
+				readers.Add([&]() {
+					while (!done.load()) {
+						auto snapshot = list.Read();
+						if (!std::is_sorted(snapshot.begin(), snapshot.end(), [](int a, int b) { return a <= b; })) ++torn;
+					}
+				});
+			}
+
+			for (int i = 0; i < 20000; i++) {
+				list.Add(i);
+				if (i % 1000 == 999) list.RemoveIf([](int e) { return e % 3 == 0; });
+			}
+			done.store(true);
+			for (auto& reader : readers) reader.join();
+
+			Assert::IsTrue(torn.load() == 0);
+			auto snapshot = list.Read();
+			Assert::IsTrue(snapshot.Count() == 20000 - 6667 && snapshot[0] == 1);
+		}
+	};
+
+
+	TEST_CLASS(ListIoTests)
+	{
+	public:
+
+		TEST_METHOD(SaveLoad_FundamentalTypes) {
+			List<uint64_t> list;
+			for (uint64_t i = 0; i < 100000; i++) list.Add(i * i);
+
+			//small chunks so the parallel path runs more than one chunk per thread
+			list_io::IoOptions options;
+			options.chunkBytes = 4096;
+			options.threads = 4;
+			SaveAsync(list, "list_io_test.bin", options).get();
+
+			List<uint64_t> loaded = LoadAsync<uint64_t>("list_io_test.bin", options).get();
+			Assert::IsTrue(loaded.Count() == list.Count() && std::equal(list.begin(), list.end(), loaded.begin()));
+
+			Assert::ExpectException<std::invalid_argument>([&]() { LoadAsync<uint32_t>("list_io_test.bin").get(); });
+			Assert::ExpectException<std::runtime_error>([&]() { LoadAsync<uint64_t>("missing_list_io_test.bin").get(); });
+
+			SaveAsync(List<uint64_t>(), "list_io_test.bin").get();
+			Assert::IsTrue(LoadAsync<uint64_t>("list_io_test.bin").get().Count() == 0);
+			std::remove("list_io_test.bin");
+		}
+
+		TEST_METHOD(SaveLoad_ClassTypes) {
+			List<std::string> list;
+			for (size_t i = 0; i < 5000; i++) list.Add(std::string(i % 50, char('a' + i % 26)) + std::to_string(i));
+			list.Add("");
+
+			//values straddle the 100 byte chunks
+			list_io::IoOptions options;
+			options.chunkBytes = 100;
+			SaveAsync(list, "list_io_test.bin", options).get();
+
+			List<std::string> loaded = LoadAsync<std::string>("list_io_test.bin", options).get();
+			Assert::IsTrue(loaded.Count() == list.Count() && std::equal(list.begin(), list.end(), loaded.begin()));
+
+			Assert::ExpectException<std::invalid_argument>([&]() { LoadAsync<int>("list_io_test.bin").get(); });
+			std::remove("list_io_test.bin");
+		}
+
+		TEST_METHOD(SaveLoad_Callbacks) {
+			List<std::string> list;
+			for (int i = 0; i < 1000; i++) list.Add(std::to_string(i));
+
+			std::promise<std::exception_ptr> saved;
+			SaveAsync(list, "list_io_test.bin", [&](std::exception_ptr error) { saved.set_value(error); });
+			Assert::IsTrue(saved.get_future().get() == nullptr);
+
+			std::promise<List<std::string>> loaded;
+			LoadAsync<std::string>("list_io_test.bin", [&](std::exception_ptr error, List<std::string> result) {
+				Assert::IsTrue(error == nullptr);
+				loaded.set_value(std::move(result));
+			});
+			List<std::string> result = loaded.get_future().get();
+			Assert::IsTrue(result.Count() == 1000 && result[999] == "999");
+
+			std::promise<std::exception_ptr> failed;
+			LoadAsync<std::string>("missing_list_io_test.bin", [&](std::exception_ptr error, List<std::string> empty) {
+				Assert::IsTrue(empty.Count() == 0);
+				failed.set_value(error);
+			});
+			Assert::IsTrue(failed.get_future().get() != nullptr);
+			std::remove("list_io_test.bin");
+		}
+
+#if LIST_HAS_COROUTINES
+		struct IoTask {
+			struct promise_type {
+				IoTask get_return_object() { return IoTask(); }
+				std::suspend_never initial_suspend() noexcept { return {}; }
+				std::suspend_never final_suspend() noexcept { return {}; }
+				void return_void() {}
+				void unhandled_exception() { std::terminate(); }
+			};
+		};
+
+		static IoTask RoundTrip(const List<int>& list, std::promise<List<int>>& done) {
+			co_await SaveAwait(list, "list_io_test.bin");
+			List<int> loaded = co_await LoadAwait<int>("list_io_test.bin");
+			bool missing = false;
+			try {
+				co_await LoadAwait<int>("missing_list_io_test.bin");
+			}
+			catch (const std::runtime_error&) {
+				missing = true;
+			}
+			if (missing) done.set_value(std::move(loaded));
+			else done.set_value(List<int>());
+		}
+
+		TEST_METHOD(SaveLoad_Awaitable) {
+			List<int> list;
+			for (int i = 0; i < 5000; i++) list.Add(i * 3);
+
+			std::promise<List<int>> done;
+			RoundTrip(list, done);
+			List<int> loaded = done.get_future().get();
+			Assert::IsTrue(loaded.Count() == 5000 && loaded[4999] == 4999 * 3);
+			std::remove("list_io_test.bin");
+		}
+#endif
+
+		TEST_METHOD(SaveLoad_CorruptFiles) {
+			//element count patched to something the file can't hold: rejected before anything is reserved
+			auto corruptCount = [](const char* path) {
+				std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+				const uint64_t count = uint64_t(1) << 60;
+				file.seekp(16);
+				file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+			};
+
+			List<uint64_t> values;
+			for (uint64_t i = 0; i < 10; i++) values.Add(i);
+			SaveAsync(values, "list_io_test.bin").get();
+			corruptCount("list_io_test.bin");
+			Assert::ExpectException<std::runtime_error>([&]() { LoadAsync<uint64_t>("list_io_test.bin").get(); });
+
+			List<std::string> strings;
+			strings.Add("abc");
+			SaveAsync(strings, "list_io_test.bin").get();
+			corruptCount("list_io_test.bin");
+			Assert::ExpectException<std::runtime_error>([&]() { LoadAsync<std::string>("list_io_test.bin").get(); });
+
+			list_io::IoOptions options;
+			options.chunkBytes = 0;
+			Assert::ExpectException<std::invalid_argument>([&]() { SaveAsync(values, "list_io_test.bin", options).get(); });
+			Assert::ExpectException<std::invalid_argument>([&]() { LoadAsync<uint64_t>("list_io_test.bin", options).get(); });
+			std::remove("list_io_test.bin");
+		}
+	};
+
+
+	TEST_CLASS(ListChannelTests)
+	{
+	public:
+
+		TEST_METHOD(ProducerBatches) {
+			ListProducer<int> producer(100, 2);
+			long long sum = 0;
+			size_t batches = 0;
+			std::thread consumer([&]() {
+				List<int> batch;
+				while (producer.Next(batch)) {
+					for (int e : batch) sum += e;
+					++batches;
+				}
+			});
+
+			//at most 2 batches wait for the consumer - the producer blocks instead of buffering everything
+			for (int i = 0; i < 10050; i++) producer.Add(i);
+			producer.Close();
+			consumer.join();
+
+			Assert::IsTrue(batches == 101 && sum == 10049LL * 10050 / 2);
+		}
+
+		TEST_METHOD(ChannelClose) {
+			ListChannel<std::string> channel(1);
+			List<std::string> batch;
+			batch.Add("a");
+			Assert::IsTrue(channel.Push(std::move(batch)));
+			channel.Close();
+
+			List<std::string> out;
+			Assert::IsTrue(channel.Pop(out) && out.Count() == 1 && out[0] == "a");
+			Assert::IsTrue(!channel.Pop(out) && !channel.Push(List<std::string>()));
+		}
+
+		TEST_METHOD(ProducerConsumerStopsEarly) {
+			ListChannel<int> channel(1);
+			List<int> batch;
+			batch.Add(1);
+			Assert::IsTrue(channel.TryPush(std::move(batch)));
+			List<int> second;
+			second.Add(2);
+			Assert::IsTrue(!channel.TryPush(std::move(second)) && second.Count() == 1);
+
+			//the consumer reads one batch and walks away with the channel full and a partial batch pending
+			{
+				ListProducer<int> producer(2, 1);
+				List<int> out;
+				producer.Add(1);
+				producer.Add(2);
+				Assert::IsTrue(producer.Next(out) && out.Count() == 2);
+				producer.Add(3);
+				producer.Add(4);
+				producer.Add(5);
+			} //must not block
+		}
+
+#if LIST_HAS_COROUTINES
+		struct Task {
+			struct promise_type {
+				Task get_return_object() { return Task(); }
+				std::suspend_never initial_suspend() noexcept { return {}; }
+				std::suspend_never final_suspend() noexcept { return {}; }
+				void return_void() {}
+				void unhandled_exception() { std::terminate(); }
+			};
+		};
+
+		static Task Consume(ListProducer<int>& producer, long long& sum, bool& finished) {
+			List<int> batch;
+			while (co_await producer.NextAsync(batch)) {
+				for (int e : batch) sum += e;
+			}
+			finished = true;
+		}
+
+		TEST_METHOD(GeneratorAndCoroutineConsumer) {
+			List<int> list;
+			for (int i = 0; i < 10; i++) list.Add(i);
+
+			//references into the list - nothing is copied
+			for (int& e : Generate(list)) e *= 2;
+			int expected = 0;
+			for (const int& e : Generate(ListView<int>(list).Slice(2, 3))) {
+				Assert::IsTrue(e == (expected + 2) * 2);
+				++expected;
+			}
+			Assert::IsTrue(expected == 3 && list[9] == 18);
+
+			//the consumer suspends until a batch arrives and is resumed by the producer
+			ListProducer<int> producer(4, 1);
+			long long sum = 0;
+			bool finished = false;
+			Consume(producer, sum, finished);
+			Assert::IsTrue(!finished);
+			for (int e : Generate(list)) producer.Add(e);
+			producer.Close();
+			Assert::IsTrue(finished && sum == 90);
+		}
+#endif
+	};
+
+
+	TEST_CLASS(ListPrefetchTests)
+	{
+	public:
+
+		TEST_METHOD(FindIfPrefetch_ClassTypes) {
+			List<std::unique_ptr<int>> owners;
+			List<const int*> pointers;
+			List<std::string> strings;
+			for (int i = 0; i < 100; i++) {
+				owners.Add(std::make_unique<int>(i));
+				pointers.Add(owners[i].get());
+				strings.Add(std::string(40, char('a' + i % 26)) + std::to_string(i));
+			}
+
+			auto owner = FindIfPrefetch(owners, [](const std::unique_ptr<int>& e) { return *e == 42; });
+			Assert::IsTrue(owner == owners.begin() + 42);
+			Assert::IsTrue(FindIfPrefetch(pointers, [](const int* e) { return *e == 99; }, AutoPrefetch(), 1000) == pointers.begin() + 99);
+			Assert::IsTrue(FindIfPrefetch(strings, [](const std::string& e) { return e.back() == 'x'; }) == nullptr);
+
+			//custom address extractor, on a view
+			size_t prefetched = 0;
+			auto address = [&](const std::string& e) {
+				++prefetched;
+				return e.data();
+			};
+			const std::string* found = FindIfPrefetch(ListView<std::string>(strings).Slice(10, 20), [](const std::string& e) { return e.back() == '5'; }, address, 4);
+			Assert::IsTrue(found == strings.begin() + 15 && prefetched == 4 + 6);
+
+			//plain values just scan
+			List<int> values;
+			values.Add(1);
+			Assert::IsTrue(FindIfPrefetch(values, [](int e) { return e == 1; }) == values.begin());
+		}
+
+		TEST_METHOD(RemoveIfPrefetch_ClassTypes) {
+			List<std::unique_ptr<std::string>> list;
+			for (int i = 0; i < 100; i++) list.Add(std::make_unique<std::string>(std::to_string(i)));
+
+			Assert::IsTrue(RemoveIfPrefetch(list, [](const std::unique_ptr<std::string>& e) { return e->size() == 1; }, AutoPrefetch(), 3) == 10);
+			Assert::IsTrue(list.Count() == 90 && *list[0] == "10" && *list[89] == "99");
+		}
+	};
+
+
+
+	TEST_CLASS(FixedListTests)
+	{
+	public:
+
+		TEST_METHOD(FixedList_FundamentalTypes) {
+			//filled at compile time through Add
+			constexpr auto squares = [] {
+				FixedList<int, 16> table;
+				for (int i = 0; i < 10; i++) table.Add(i * i);
+				return table;
+			}();
+			static_assert(squares.Count() == 10 && squares[9] == 81);
+			static_assert(squares.Contains(49) && !squares.Contains(50));
+			static_assert(squares.LowerBound(50) == 8 && squares.LowerBound(100) == 10);
+
+			constexpr FixedList<char, 4> letters = { 'a', 'b', 'c' };
+			static_assert(letters.Find('c') == letters.begin() + 2);
+
+			Assert::IsTrue(squares.Get(3) == 9);
+			Assert::ExpectException<std::out_of_range>([&] { squares.Get(10); });
+			FixedList<char, 4> full = letters;
+			full.Add('d');
+			Assert::ExpectException<std::length_error>([&] { full.Add('e'); });
+
+			List<int> list = squares.ToList();
+			Assert::IsTrue(list.Count() == 10 && list[4] == 16);
+			Assert::IsTrue(ToFixedList<10>(list).FindIf([](int e) { return e > 20; }) != nullptr);
+			Assert::ExpectException<std::length_error>([&] { ToFixedList<9>(list); });
+		}
+
+#if LIST_HAS_CONSTEXPR
+		TEST_METHOD(ConstexprList_FundamentalTypes) {
+			//a growing List in constant evaluation: Add (with reallocations), Sort, RemoveAt, Find
+			constexpr auto primes = [] {
+				List<int> list;
+				for (int n = 97; n >= 2; n--) {
+					bool prime = true;
+					for (int d = 2; d * d <= n; d++) {
+						if (n % d == 0) prime = false;
+					}
+					if (prime) list.Add(n);
+				}
+				list.Sort();
+				return list;
+			};
+			static_assert(primes().Count() == 25);
+
+			constexpr auto table = ToFixedList<primes().Count()>(primes());
+			static_assert(table[0] == 2 && table[24] == 97 && table.Contains(53));
+
+			constexpr size_t removed = [] {
+				List<int> list;
+				for (int i = 0; i < 20; i++) list.Add(i % 5);
+				list.RemoveAt(0);
+				List<int> copy = list;
+				copy.Sort([](int a, int b) { return a > b; });
+				return list.RemoveIf([](int e) { return e == 4; }) * 100 + size_t(copy[0]) * 10 + (list.Find(1) - list.begin());
+			}();
+			static_assert(removed == 4 * 100 + 4 * 10 + 0);
+
+			Assert::IsTrue(table.LowerBound(60) == 17);
+		}
+#endif
+	};
 }
\ No newline at end of file